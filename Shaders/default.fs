@@ -22,8 +22,19 @@ struct Light {
 #define MAX_LIGHTS 4
 
 uniform Material material;
-uniform Light lights[MAX_LIGHTS];
-uniform vec3 viewPos;
+
+// Câmera e luzes do frame (FrameUniforms), as mesmas para todos os objetos
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+layout (std140) uniform Lights
+{
+    Light lights[MAX_LIGHTS];
+};
 
 // Função para calcular o efeito metálico cobre-ouro
 vec3 calculateMetallicEffect(vec2 texCoords, vec3 normal, vec3 viewDir) {
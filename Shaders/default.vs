@@ -8,13 +8,36 @@ out vec3 Normal;
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// Câmera do frame (FrameUniforms::CameraBlock), a mesma para todos os objetos
+layout (std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+// Formato dos vértices (VertexFormat): no Packed a posição chega em inteiros relativos à caixa da malha e a normal
+// em octaedro (só x e y). No Float32 a escala é 1, o deslocamento é 0 e octNormal é false.
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+uniform bool octNormal;
+
+vec3 decodeOctahedron(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 position = positionOffset + positionScale * aPos;
+    vec3 normal = octNormal ? decodeOctahedron(aNormal.xy / 32767.0) : aNormal;
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(model))) * normal;
     TexCoords = aTexCoords;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
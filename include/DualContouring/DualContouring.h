@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <glm/vec3.hpp>
+#include <glm/ext/vector_int3.hpp>
+
+namespace DualContouring
+{
+    /** Contadores de uma chamada, preenchidos quando Settings::stats aponta para eles. */
+    struct Stats
+    {
+        size_t gridSamples = 0;
+        /** Células da grade fina cruzadas pela superfície (folhas da octree). */
+        size_t leafCells = 0;
+        /** Nós internos colapsados em um único vértice. */
+        size_t collapsedNodes = 0;
+        size_t vertices = 0;
+        size_t triangles = 0;
+        /** Amostragem + dados de Hermite, e octree + contorno. */
+        double sampleMs = 0.0;
+        double buildMs = 0.0;
+    };
+
+    /** Opções do Dual Contouring. */
+    struct Settings
+    {
+        /** Número de threads da amostragem e dos dados de Hermite. 1 = serial, 0 = todos os núcleos. */
+        unsigned int threadCount = 1;
+
+        bool invertFaceSide = false;
+
+        /** Faixa estreita, como em Polygonizer::Settings: só os blocos perto da superfície são amostrados. */
+        bool adaptive = false;
+        int blockSize = 8;
+        float lipschitz = 1.0f;
+
+        /** Erro máximo da QEF (soma dos quadrados das distâncias aos planos de Hermite) para colapsar
+         * um nó da octree em um vértice. 0 mantém todas as células da grade fina. */
+        float errorTolerance = 1e-6f;
+
+        /** Faces cujo ângulo com a normal do vértice passa disso ganham um vértice próprio com a normal da
+         * face, para as quinas ficarem vivas no sombreamento. Valores >= 180 desligam a separação. */
+        float creaseAngleDeg = 30.0f;
+
+        Stats* stats = nullptr;
+
+        /** Avanço e cancelamento, como em Polygonizer::Settings. */
+        std::atomic<float>* progress = nullptr;
+        const std::atomic<bool>* cancel = nullptr;
+    };
+
+    /** @brief Dual Contouring em octree (Ju et al. 2002) sobre a grade (resolution+1)^3 de [minCorner, maxCorner].
+     * Cada célula cruzada pela superfície guarda os dados de Hermite das suas arestas (ponto de cruzamento
+     * e normal); o vértice da célula minimiza a QEF desses planos, o que preserva quinas e arestas vivas.
+     * Regiões planas são colapsadas em células maiores enquanto a QEF ficar abaixo de errorTolerance e a
+     * topologia for preservada; quinas e arestas ficam na resolução da grade fina. Saída no mesmo formato do Polygonizer: pos(3), normal(3), UV(2) e índices.
+     *
+     * O SDF segue o mesmo contrato do Polygonizer::PolygonizeSurface (callable e/ou evaluate em lote);
+     * se tiver gradient(), as normais de Hermite são exatas, senão usam diferenças centrais. */
+    template<typename SDF>
+    void ContourSurface(const SDF& sdf,
+        const glm::vec3& minCorner,
+        const glm::vec3& maxCorner,
+        int resolution,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
+
+    /** @brief Mesma coisa com o número de células de cada eixo (ver Polygonizer::IsotropicCells). */
+    template<typename SDF>
+    void ContourSurface(const SDF& sdf,
+        const glm::vec3& minCorner,
+        const glm::vec3& maxCorner,
+        const glm::ivec3& resolution,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
+}
+
+#include "DualContouring/DualContouringDetail.h"
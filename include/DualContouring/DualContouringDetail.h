@@ -0,0 +1,198 @@
+#pragma once
+
+// Implementação dos templates declarados em DualContouring.h. Não inclua diretamente.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include "MarchingCubes/Polygonizer.h"
+
+namespace DualContouring::Detail
+{
+    // Função de erro quadrático de um conjunto de planos de Hermite n·x = n·p, guardada como A^T A, A^T b e b^T b
+    struct Qef
+    {
+        float ata[6] = { 0, 0, 0, 0, 0, 0 };   // xx, xy, xz, yy, yz, zz
+        glm::vec3 atb{ 0.0f };
+        float btb = 0.0f;
+        glm::vec3 massSum{ 0.0f };
+        int count = 0;
+
+        void add(const glm::vec3& p, const glm::vec3& n)
+        {
+            const float d = glm::dot(n, p);
+            ata[0] += n.x * n.x; ata[1] += n.x * n.y; ata[2] += n.x * n.z;
+            ata[3] += n.y * n.y; ata[4] += n.y * n.z; ata[5] += n.z * n.z;
+            atb += n * d;
+            btb += d * d;
+            massSum += p;
+            ++count;
+        }
+
+        void merge(const Qef& other)
+        {
+            for (int i = 0; i < 6; ++i) ata[i] += other.ata[i];
+            atb += other.atb;
+            btb += other.btb;
+            massSum += other.massSum;
+            count += other.count;
+        }
+    };
+
+    // Célula da grade fina cruzada pela superfície: sinais dos cantos e os dados de Hermite das suas arestas
+    struct HermiteCell
+    {
+        glm::ivec3 cell;
+        uint8_t corners;        // bit c ligado quando o canto c está dentro (sdf < 0)
+        Qef qef;
+        glm::vec3 normalSum;
+    };
+
+    // O canto c de uma célula fica no deslocamento ((c>>2)&1, (c>>1)&1, c&1); arestas ligam cantos que diferem em um bit
+    constexpr int EDGE_CORNERS[12][2] = {
+        {0,4},{1,5},{2,6},{3,7},    // x
+        {0,2},{1,3},{4,6},{5,7},    // y
+        {0,1},{2,3},{4,5},{6,7}     // z
+    };
+
+    /** Octree, simplificação e contorno sobre as células de Hermite; independe do SDF. */
+    void BuildMesh(const std::vector<float>& grid, const Polygonizer::Detail::Lattice& lattice,
+        std::vector<HermiteCell>& cells, const Settings& settings,
+        std::vector<float>& outVerts, std::vector<unsigned int>& outIdx);
+}
+
+template<typename SDF>
+void DualContouring::ContourSurface(const SDF& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    int resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    ContourSurface(sdf, minCorner, maxCorner, glm::ivec3(resolution), outVerts, outIdx, settings);
+}
+
+template<typename SDF>
+void DualContouring::ContourSurface(const SDF& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    const glm::ivec3& resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    using namespace DualContouring::Detail;
+    namespace Grid = Polygonizer::Detail;
+
+    const auto sampleStart = std::chrono::steady_clock::now();
+
+    const glm::vec3 cellSize = (maxCorner - minCorner) / glm::vec3(resolution);
+    const unsigned int threads = Grid::ResolveThreadCount(settings.threadCount);
+
+    // 1) Amostra o SDF nos nós da grade. No modo adaptativo só a faixa estreita é amostrada;
+    //    os nós descartados recebem um valor com o sinal certo, já que a octree testa sinais em qualquer ponto da grade.
+    const Grid::Lattice lattice{ minCorner, cellSize, resolution };
+    const glm::ivec3 nodes = lattice.nodes();
+    const size_t stride = static_cast<size_t>(nodes.x);
+    // Uma unidade por plano amostrado, uma por camada de Hermite e uma para a octree
+    Grid::BuildProgress progress(settings.progress, settings.cancel, static_cast<size_t>(nodes.z) + resolution.z + 1);
+    std::vector<float> grid(lattice.planeSize() * nodes.z);
+    auto idx3 = [&](int i, int j, int k){ return i + stride*(j + static_cast<size_t>(nodes.y)*k); };
+
+    Grid::BlockGrid blocks;
+    Grid::MakeBlockGrid(sdf, lattice, settings.adaptive, settings.blockSize, settings.lipschitz, blocks);
+    if (settings.adaptive)
+        Grid::FillCulledNodes(blocks, resolution, grid);
+    const size_t gridSamples = Grid::SampleActiveNodes(sdf, lattice, threads, blocks, 0, grid, progress);
+    if (progress.cancelled()) return;
+
+    // 2) Dados de Hermite (ponto de cruzamento + normal) nas arestas de toda célula com troca de sinal. Cada fatia em Z
+    //    guarda em cache o plano de arestas anterior e o atual, então a maioria das normais é avaliada uma vez só.
+    const int slabCount = std::max(1, std::min(resolution.z, static_cast<int>(threads) * 4));
+    std::vector<std::vector<HermiteCell>> slabCells(slabCount);
+    Grid::ParallelFor(slabCount, threads, [&](const int s)
+    {
+        struct EdgeSample { glm::vec3 p, n; bool valid; };
+        std::vector<EdgeSample> samples;
+
+        // Posições do plano (P = nodes.x*nodes.y): arestas X em i + stride*j, arestas Y em P + i + stride*j; arestas Z da camada em i + stride*j
+        const size_t planeSlots = lattice.planeSize();
+        std::vector<int> bottom(2 * planeSlots, -1), top(2 * planeSlots), layer(planeSlots);
+
+        const int kBegin = resolution.z * s / slabCount;
+        const int kEnd   = resolution.z * (s + 1) / slabCount;
+        for(int k = kBegin; k < kEnd && !progress.cancelled(); ++k) {
+            std::fill(top.begin(), top.end(), -1);
+            std::fill(layer.begin(), layer.end(), -1);
+            const int bk = k / blocks.blockSize;
+
+            for(int j = 0; j < resolution.y; ++j) {
+                const int bj = j / blocks.blockSize;
+                for(int i = 0; i < resolution.x; ++i) {
+                    // Células de blocos descartados não têm cruzamento; pula a linha inteira do bloco
+                    if (!blocks.isActive(i / blocks.blockSize, bj, bk)) {
+                        i = (i / blocks.blockSize + 1) * blocks.blockSize - 1;
+                        continue;
+                    }
+
+                    float val[8];
+                    uint8_t corners = 0;
+                    for(int c = 0; c < 8; ++c) {
+                        val[c] = grid[idx3(i + ((c>>2)&1), j + ((c>>1)&1), k + (c&1))];
+                        if (val[c] < 0.0f) corners |= static_cast<uint8_t>(1u << c);
+                    }
+                    if (corners == 0 || corners == 0xFF) continue;
+
+                    HermiteCell cell{ glm::ivec3(i, j, k), corners, Qef{}, glm::vec3(0.0f) };
+                    for(int e = 0; e < 12; ++e) {
+                        const int a = EDGE_CORNERS[e][0], b = EDGE_CORNERS[e][1];
+                        if (((corners >> a) & 1) == ((corners >> b) & 1)) continue;
+
+                        const glm::ivec3 o((a>>2)&1, (a>>1)&1, a&1);
+                        int& id = e < 4 ? (o.z ? top : bottom)[i + stride*static_cast<size_t>(j + o.y)]
+                                : e < 8 ? (o.z ? top : bottom)[planeSlots + (i + o.x) + stride*static_cast<size_t>(j)]
+                                : layer[(i + o.x) + stride*static_cast<size_t>(j + o.y)];
+                        if (id < 0) {
+                            const glm::vec3 pA = minCorner + glm::vec3(glm::ivec3(i, j, k) + o) * cellSize;
+                            const glm::vec3 pB = minCorner + glm::vec3(i + ((b>>2)&1), j + ((b>>1)&1), k + (b&1)) * cellSize;
+                            const float t = val[a] / (val[a] - val[b]);
+                            const glm::vec3 p = pA + t * (pB - pA);
+                            const glm::vec3 n = Grid::AnalyticNormal(sdf, p);
+                            // Sem gradiente utilizável (NaN ou zero): a aresta não acrescenta plano
+                            samples.push_back({ p, n, glm::dot(n, n) > 0.5f });
+                            id = static_cast<int>(samples.size() - 1);
+                        }
+
+                        const EdgeSample& sample = samples[id];
+                        if (!sample.valid) continue;
+                        cell.qef.add(sample.p, sample.n);
+                        cell.normalSum += sample.n;
+                    }
+                    slabCells[s].push_back(cell);
+                }
+            }
+
+            std::swap(bottom, top);
+            progress.advance();
+        }
+    });
+    if (progress.cancelled()) return;
+
+    std::vector<HermiteCell> cells;
+    size_t cellCount = 0;
+    for(const auto& slab : slabCells) cellCount += slab.size();
+    cells.reserve(cellCount);
+    for(auto& slab : slabCells) {
+        cells.insert(cells.end(), slab.begin(), slab.end());
+        std::vector<HermiteCell>().swap(slab);
+    }
+
+    const auto buildStart = std::chrono::steady_clock::now();
+
+    // 3) Octree + simplificação + contorno
+    BuildMesh(grid, lattice, cells, settings, outVerts, outIdx);
+    progress.advance();
+
+    if (settings.stats) {
+        Stats& stats = *settings.stats;
+        stats.gridSamples = gridSamples;
+        stats.leafCells = cellCount;
+        stats.sampleMs = std::chrono::duration<double, std::milli>(buildStart - sampleStart).count();
+        stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/ext/vector_int2.hpp>
+
+namespace Extrusion
+{
+    /** Contadores de uma chamada, preenchidos quando Settings::stats aponta para eles. */
+    struct Stats
+    {
+        /** Nós da grade 2D avaliados (sem os copiados por simetria). */
+        size_t profileSamples = 0;
+        /** Cruzamentos do contorno com as arestas da grade (marching squares). */
+        size_t contourPoints = 0;
+        /** Quinas vivas recuperadas dentro das células. */
+        size_t cornerPoints = 0;
+        /** Vértices dos contornos depois de juntar os trechos retos. */
+        size_t outlinePoints = 0;
+        size_t loops = 0;
+        size_t vertices = 0;
+        size_t triangles = 0;
+        /** Amostragem + normais, e contorno + tampas + paredes. */
+        double sampleMs = 0.0;
+        double buildMs = 0.0;
+    };
+
+    /** Opções da extrusão. */
+    struct Settings
+    {
+        /** Número de threads da amostragem. 1 = serial, 0 = todos os núcleos. */
+        unsigned int threadCount = 1;
+
+        bool invertFaceSide = false;
+
+        /** Máximo de passos de falsa posição que levam cada cruzamento até a raiz do SDF na aresta (a interpolação
+         * linear erra onde o campo dobra entre os dois nós, como nas quinas internas de uma subtração). Onde o
+         * campo é linear, o primeiro passo já acerta. 0 = só a interpolação linear. */
+        int refineSteps = 8;
+
+        /** Quando as normais dos dois cruzamentos de uma célula diferem mais do que isso, o contorno ganha um
+         * vértice na interseção das duas retas tangentes (quina viva em vez do chanfro do marching squares).
+         * Também é o ângulo a partir do qual as paredes separam as normais em um vértice. >= 180 desliga os dois. */
+        float creaseAngleDeg = 30.0f;
+
+        /** Pontos do contorno a menos disso (em frações do tamanho da célula) da reta entre os vizinhos
+         * são removidos: trechos retos viram um único segmento. 0 remove só os repetidos e os exatamente alinhados. */
+        float simplifyTolerance = 0.01f;
+
+        /** Planos de simetria do perfil, como em Polygonizer::Settings: com symmetry.x o perfil tem de ser o mesmo
+         * dos dois lados de x = symmetryPlane.x (idem em Y). Só os nós do lado de cima de cada plano são amostrados,
+         * os outros copiam o espelho. O plano passa a ser uma linha de nós (o eixo ganha um número par de células
+         * do mesmo tamanho, cobrindo o domínio). */
+        glm::bvec2 symmetry{ false };
+        glm::vec2 symmetryPlane{ 0.0f };
+
+        Stats* stats = nullptr;
+
+        /** Avanço e cancelamento, como em Polygonizer::Settings. */
+        std::atomic<float>* progress = nullptr;
+        const std::atomic<bool>* cancel = nullptr;
+    };
+
+    /** @brief Malha de um perfil 2D extrudado em Z: marching squares no plano, tampas triangulando o contorno
+     * e paredes extrudando-o. São (cells.x+1)*(cells.y+1) avaliações em vez das (n+1)^3 do Polygonizer, as tampas
+     * são planas e os trechos retos viram poucos triângulos. Saída no mesmo formato do Polygonizer: pos(3),
+     * normal(3), UV(2) e índices.
+     *
+     * O SDF segue o mesmo contrato do Polygonizer::PolygonizeSurface e é avaliado no plano z = (zMin + zMax)/2:
+     * para uma forma que já é um perfil extrudado (max(perfil(x, y), |z| - meia espessura)), é o próprio perfil.
+     * Se tiver gradient(), as normais das paredes são exatas, senão usam diferenças centrais.
+     * Contornos que tocam a borda de [minCorner, maxCorner] são fechados na borda. */
+    template<typename SDF>
+    void ExtrudeProfile(const SDF& sdf,
+        const glm::vec2& minCorner,
+        const glm::vec2& maxCorner,
+        const glm::ivec2& cells,
+        float zMin,
+        float zMax,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
+}
+
+#include "Extrusion/ExtrusionDetail.h"
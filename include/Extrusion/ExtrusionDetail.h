@@ -0,0 +1,188 @@
+#pragma once
+
+// Implementação dos templates declarados em Extrusion.h. Não inclua diretamente.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "MarchingCubes/Polygonizer.h"
+
+namespace Extrusion::Detail
+{
+    // Valor do anel de nós em volta do domínio: sempre fora, para todo contorno fechar
+    constexpr float OUTSIDE = 1e30f;
+
+    // Grade 2D de amostras do perfil com um nó a mais de cada lado (o anel OUTSIDE).
+    // O nó (a, b) do anel é o nó (a-1, b-1) do domínio.
+    struct Profile
+    {
+        glm::vec2 minCorner;
+        glm::vec2 cellSize;
+        glm::ivec2 cells;
+        std::vector<float> values;
+
+        int stride() const { return cells.x + 3; }
+        int rows() const { return cells.y + 3; }
+        float value(const int a, const int b) const { return values[a + static_cast<size_t>(stride()) * b]; }
+        glm::vec2 node(const int a, const int b) const { return minCorner + glm::vec2(a - 1, b - 1) * cellSize; }
+    };
+
+    // Aresta da grade com troca de sinal: as pontas dela e as suas amostras
+    struct CrossingEdge
+    {
+        glm::vec2 p0, p1;
+        float v0, v1;
+    };
+
+    // Cruzamentos do contorno com as arestas da grade com anel. A aresta X (a,b)-(a+1,b) e a aresta Y (a,b)-(a,b+1)
+    // são endereçadas por a + stride*b; -1 quando a aresta não tem cruzamento.
+    struct Crossings
+    {
+        std::vector<int> xEdge, yEdge;
+        std::vector<CrossingEdge> edges;
+        std::vector<glm::vec2> points;
+        // Normal unitária para fora de cada ponto em XY; zero quando o SDF não tem gradiente utilizável ali
+        std::vector<glm::vec2> normals;
+    };
+
+    /** Cruzamentos do contorno (interpolação linear em cada aresta com troca de sinal). */
+    void FindCrossings(const Profile& profile, Crossings& crossings);
+
+    // Leva um cruzamento até a raiz do SDF na sua aresta (falsa posição, variante de Illinois), parando assim que
+    // |sdf| <= tolerance. O chute linear erra onde o campo dobra entre os dois nós, p. ex. em volta das
+    // quinas internas de uma subtração ou onde um max() com um plano distante o achata.
+    template<typename SDF>
+    glm::vec2 RefineCrossing(const SDF& sdf, const CrossingEdge& edge, const float z, const int steps, const float tolerance)
+    {
+        glm::vec2 a = edge.p0, b = edge.p1;
+        float fa = edge.v0, fb = edge.v1;
+        // Cruzamentos com o anel OUTSIDE fecham o contorno na borda; não há o que refinar
+        if (fa >= OUTSIDE || fb >= OUTSIDE) return a + fa / (fa - fb) * (b - a);
+
+        int side = 0;
+        for (int s = 0; s < steps; ++s) {
+            const glm::vec2 x = a + fa / (fa - fb) * (b - a);
+            const float fx = Polygonizer::Detail::EvaluatePoint(sdf, glm::vec3(x, z));
+            if (std::abs(fx) <= tolerance) return x;
+            if ((fx < 0.0f) == (fa < 0.0f)) {
+                a = x; fa = fx;
+                if (side == -1) fb *= 0.5f;
+                side = -1;
+            }
+            else {
+                b = x; fb = fx;
+                if (side == 1) fa *= 0.5f;
+                side = 1;
+            }
+        }
+        return a + fa / (fa - fb) * (b - a);
+    }
+
+    /** Contornos, quinas, simplificação, tampas e paredes; independe do SDF. */
+    void BuildMesh(const Profile& profile, const Crossings& crossings, float zMin, float zMax, const Settings& settings,
+        std::vector<float>& outVerts, std::vector<unsigned int>& outIdx);
+}
+
+template<typename SDF>
+void Extrusion::ExtrudeProfile(const SDF& sdf, const glm::vec2& minCorner, const glm::vec2& maxCorner,
+    const glm::ivec2& cells, const float zMin, const float zMax,
+    std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    using namespace Extrusion::Detail;
+    namespace Grid = Polygonizer::Detail;
+
+    const auto sampleStart = std::chrono::steady_clock::now();
+
+    Profile profile;
+    profile.minCorner = minCorner;
+    profile.cells = glm::max(cells, glm::ivec2(1));
+    profile.cellSize = (maxCorner - minCorner) / glm::vec2(profile.cells);
+
+    // Cada plano de simetria vira a linha de nós do meio de um número par de células do mesmo tamanho; os nós
+    // abaixo dela (first[a] deles) espelham os de cima
+    glm::ivec2 first(0);
+    for (int a = 0; a < 2; ++a) {
+        if (!settings.symmetry[a]) continue;
+        const float plane = settings.symmetryPlane[a];
+        const float reach = std::max(maxCorner[a] - plane, plane - minCorner[a]);
+        first[a] = std::max(1, static_cast<int>(std::ceil(reach / profile.cellSize[a] - 1e-4f)));
+        profile.cells[a] = 2 * first[a];
+        profile.minCorner[a] = plane - float(first[a]) * profile.cellSize[a];
+    }
+    profile.values.assign(static_cast<size_t>(profile.stride()) * profile.rows(), OUTSIDE);
+
+    const float zMid = 0.5f * (zMin + zMax);
+    const unsigned int threads = Grid::ResolveThreadCount(settings.threadCount);
+    const int rowNodes = profile.cells.x + 1 - first.x;
+    const int rowCount = profile.cells.y + 1 - first.y;
+    // Uma unidade por linha amostrada, uma para as normais e uma para a malha
+    Grid::BuildProgress progress(settings.progress, settings.cancel, static_cast<size_t>(rowCount) + 2);
+
+    // 1) Amostra o perfil no plano do meio, linha a linha, nos nós internos da grade com anel
+    std::vector<float> xs(rowNodes);
+    for (int i = 0; i < rowNodes; ++i)
+        xs[i] = profile.node(first.x + i + 1, 1).x;
+
+    const int stride = profile.stride();
+    const int chunkCount = std::max(1, std::min(rowCount, static_cast<int>(threads) * 4));
+    Grid::ParallelFor(chunkCount, threads, [&](const int c)
+    {
+        std::vector<float> ys(rowNodes), zs(rowNodes);
+        const int jEnd = first.y + rowCount * (c + 1) / chunkCount;
+        for (int j = first.y + rowCount * c / chunkCount; j < jEnd && !progress.cancelled(); ++j) {
+            float* row = profile.values.data() + 1 + static_cast<size_t>(stride) * (j + 1);
+            Grid::SampleRow(sdf, xs.data(), profile.node(1, j + 1).y, zMid, row + first.x, rowNodes, ys, zs);
+            for (int i = 0; i < first.x; ++i)
+                row[i] = row[2 * first.x - i];
+            progress.advance();
+        }
+    });
+    if (progress.cancelled()) return;
+    for (int j = 0; j < first.y; ++j)
+        std::copy_n(profile.values.data() + 1 + static_cast<size_t>(stride) * (2 * first.y - j + 1), profile.cells.x + 1,
+            profile.values.data() + 1 + static_cast<size_t>(stride) * (j + 1));
+
+    // 2) Pontos do contorno, levados até a superfície, e as suas normais (as paredes são sombreadas com elas, e
+    //    as quinas vivas são reconstruídas a partir das retas tangentes que elas definem)
+    Crossings crossings;
+    FindCrossings(profile, crossings);
+
+    const int pointCount = static_cast<int>(crossings.points.size());
+    crossings.normals.resize(pointCount);
+    const float refineTolerance = 1e-4f * std::min(profile.cellSize.x, profile.cellSize.y);
+    const int normalChunks = std::max(1, std::min(pointCount, static_cast<int>(threads) * 4));
+    Grid::ParallelFor(normalChunks, threads, [&](const int c)
+    {
+        const int end = pointCount * (c + 1) / normalChunks;
+        for (int p = pointCount * c / normalChunks; p < end; ++p) {
+            if (settings.refineSteps > 0)
+                crossings.points[p] = RefineCrossing(sdf, crossings.edges[p], zMid, settings.refineSteps, refineTolerance);
+            const glm::vec3 n = Grid::AnalyticNormal(sdf, glm::vec3(crossings.points[p], zMid));
+            const glm::vec2 nxy(n.x, n.y);
+            const float len = glm::length(nxy);
+            // NaN ou gradiente ao longo de Z: o ponto fica sem normal e usa as normais dos segmentos
+            crossings.normals[p] = len > 1e-4f ? nxy / len : glm::vec2(0.0f);
+        }
+    });
+    progress.advance();
+    if (progress.cancelled()) return;
+
+    const auto buildStart = std::chrono::steady_clock::now();
+
+    // 3) Contornos, tampas e paredes
+    BuildMesh(profile, crossings, zMin, zMax, settings, outVerts, outIdx);
+    progress.advance();
+
+    if (settings.stats) {
+        Stats& stats = *settings.stats;
+        stats.profileSamples = static_cast<size_t>(rowNodes) * rowCount;
+        stats.sampleMs = std::chrono::duration<double, std::milli>(buildStart - sampleStart).count();
+        stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    }
+}
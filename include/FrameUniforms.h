@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Light.h"
+#include "Utility/Constants/EngineLimits.h"
+
+/** Dados que mudam uma vez por frame e são iguais para todos os objetos (câmera e luzes), em uniform blocks std140.
+ * O Renderer atualiza os dois buffers uma vez por frame; cada programa só liga os blocos aos binding points fixos
+ * ao ser vinculado (ShaderRegistry), e cada desenho envia só o que é do objeto (matriz model e material). */
+namespace FrameUniforms
+{
+    /** Binding points dos blocos "Camera" e "Lights" dos shaders. */
+    constexpr unsigned int CAMERA_BINDING = 0;
+    constexpr unsigned int LIGHTS_BINDING = 1;
+
+    /** Espelho std140 de `uniform Camera { mat4 view; mat4 projection; vec3 viewPos; }`. */
+    struct CameraBlock
+    {
+        glm::mat4 view{ 1.0f };
+        glm::mat4 projection{ 1.0f };
+        glm::vec3 viewPos{ 0.0f };
+        float padding = 0.0f;
+    };
+    static_assert(sizeof(CameraBlock) == 144, "CameraBlock tem que seguir o layout std140");
+
+    /** Espelho std140 da struct Light do default.fs: em std140 o float seguinte a um vec3 ocupa o quarto componente. */
+    struct LightStd140
+    {
+        glm::vec3 position{ 0.0f };
+        float padding0 = 0.0f;
+        glm::vec3 color{ 0.0f };
+        float constant = 1.0f;
+        float linear = 0.0f;
+        float quadratic = 0.0f;
+        float padding1[2] = { 0.0f, 0.0f };
+    };
+    static_assert(sizeof(LightStd140) == 48, "LightStd140 tem que seguir o layout std140");
+
+    /** Espelho std140 de `uniform Lights { Light lights[MAX_LIGHTS]; }`. */
+    struct LightsBlock
+    {
+        LightStd140 lights[EngineLimits::MAX_LIGHTS];
+    };
+
+    /** @brief Liga os blocos "Camera" e "Lights" do programa, se ele os declarar, aos binding points acima.
+     * Chamado uma vez por programa, logo depois de vinculá-lo. */
+    void BindBlocks(unsigned int program);
+
+    /** Os dois uniform buffers de um contexto OpenGL. Criados no create (com o contexto já ativo) e apagados
+     * no destrutor. */
+    class Buffers
+    {
+    public:
+        Buffers() = default;
+        ~Buffers();
+        Buffers(const Buffers&) = delete;
+        Buffers& operator=(const Buffers&) = delete;
+
+        /** @brief Cria os buffers e os liga aos binding points. */
+        void create();
+
+        /** @brief Envia a câmera e as luzes do frame: uma escrita por buffer, para todos os programas.
+         * Luzes além de EngineLimits::MAX_LIGHTS são ignoradas; as que faltam ficam apagadas (cor 0). */
+        void update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos, const std::vector<Light>& lights);
+
+    private:
+        unsigned int m_camera = 0;
+        unsigned int m_lights = 0;
+    };
+}
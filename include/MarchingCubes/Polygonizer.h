@@ -1,11 +1,100 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include <functional>
 #include <glm/vec3.hpp>
+#include <glm/ext/vector_int3.hpp>
 
 namespace Polygonizer
 {
+    /** Como a normal de cada vértice é calculada. */
+    enum class NormalMode
+    {
+        /** Diferenças centrais no SDF (eps = 1e-3): 6 avaliações extras por vértice. */
+        CentralDifference,
+        /** Gradiente da grade já amostrada (diferenças centrais nos nós, interpolado ao longo da aresta): nenhuma avaliação extra. */
+        GridGradient,
+        /** Gradiente exato via sdf.gradient(p) (ex.: números duais no LaneSDF); sem gradient(), usa CentralDifference. */
+        Analytic
+    };
+
+    /** Contadores de uma chamada, preenchidos quando Settings::stats aponta para eles. */
+    struct Stats
+    {
+        /** Nós da grade avaliados. */
+        size_t gridSamples = 0;
+        /** Avaliações nos centros dos blocos durante o descarte (modo adaptativo). */
+        size_t boundSamples = 0;
+        size_t activeBlocks = 0;
+        size_t totalBlocks = 0;
+        /** Descarte + amostragem, e extração + normais + junção. */
+        double sampleMs = 0.0;
+        double extractMs = 0.0;
+        /** Avaliações gastas ajustando a caixa (Settings::autoBounds). */
+        size_t fitSamples = 0;
+        /** Nós da grade densa que a caixa ajustada deixou de fora: (resolution+1)^3 do domínio menos os da caixa. */
+        size_t savedSamples = 0;
+        /** Caixa efetivamente amostrada (o domínio, sem autoBounds). */
+        glm::vec3 fittedMin{ 0.0f }, fittedMax{ 0.0f };
+        /** Vértices criados espelhando a região fundamental (Settings::symmetry); os outros contadores são dela. */
+        size_t mirroredVertices = 0;
+        /** Células com cruzamento, as únicas visitadas na extração (as outras saem em lotes de 64 pelos bits de sinal). */
+        size_t activeCells = 0;
+    };
+
+    /** Opções de execução do Marching Cubes.
+     * Em todas as sobrecargas a malha sai indexada: cada cruzamento de aresta da grade vira um único
+     * vértice, compartilhado pelos triângulos vizinhos. */
+    struct Settings
+    {
+        /** Número de threads usadas na amostragem e na extração.
+         * 1 = serial, 0 = std::thread::hardware_concurrency().
+         * A saída é idêntica byte a byte para qualquer número de threads. */
+        unsigned int threadCount = 1;
+
+        bool invertFaceSide = false;
+
+        NormalMode normalMode = NormalMode::CentralDifference;
+
+        /** Faixa estreita: subdivide o domínio em octree e descarta blocos de blockSize^3 células com
+         * |sdf(centro)| > lipschitz * meia-diagonal, que não podem conter superfície. Só os blocos
+         * restantes são amostrados e percorridos; a malha é a mesma do modo denso. */
+        bool adaptive = false;
+        int blockSize = 8;
+        /** Limite de |∇sdf|. 1 para um SDF exato; maior para campos que só aproximam a distância. */
+        float lipschitz = 1.0f;
+
+        /** Em vez da grade (resolution+1)^3 inteira, mantém só as fatias Z que a camada atual lê (2, ou 4 com
+         * GridGradient) e escreve os triângulos de cada camada direto na saída: memória O(resolution^2).
+         * A malha é a mesma; a amostragem de cada fatia usa as threads, a extração é serial. */
+        bool streaming = false;
+
+        /** Caixa automática: minCorner/maxCorner passam a ser só o domínio de busca. Antes da amostragem, uma
+         * descida em octree (limites intervalares do SDF, se ele tiver bounds(min, max), ou a constante de
+         * Lipschitz) acha as células que podem conter a superfície; a grade encolhe para elas, alinhada à grade
+         * original (mesmo tamanho de célula, mesma malha). */
+        bool autoBounds = false;
+        /** Margem, em células, em volta das células achadas por autoBounds. */
+        int autoBoundsPadding = 1;
+
+        /** Planos de simetria: com symmetry[a], o SDF tem de ser o mesmo dos dois lados do plano
+         * (eixo a) = symmetryPlane[a]. Só a região do lado de cima de cada plano é amostrada e extraída; o resto
+         * é o espelho dela, com a ordem dos triângulos invertida e os vértices do plano compartilhados pelas duas
+         * metades. Cada plano corta o trabalho pela metade. O plano passa a ser um plano de nós da grade (a metade
+         * ganha ceil(células/2) células do mesmo tamanho), então a caixa espelhada pode passar meia célula do domínio. */
+        glm::bvec3 symmetry{ false };
+        glm::vec3 symmetryPlane{ 0.0f };
+
+        Stats* stats = nullptr;
+
+        /** Avanço da chamada em [0, 1], atualizado a cada plano amostrado e camada extraída (pode ser lido de outra thread). */
+        std::atomic<float>* progress = nullptr;
+        /** Quando vira true (em outra thread), a chamada para no próximo plano/camada e retorna sem mexer na saída. */
+        const std::atomic<bool>* cancel = nullptr;
+    };
+
     void PolygonizeSurface(const std::function<float(const glm::vec3&)>& sdf,
         const glm::vec3& minCorner,
         const glm::vec3& maxCorner,
@@ -13,5 +102,52 @@ namespace Polygonizer
         std::vector<float>& outVerts,
         std::vector<unsigned int>& outIdx,
         bool invertFaceSide = false
-    );    
+    );
+
+    void PolygonizeSurface(const std::function<float(const glm::vec3&)>& sdf,
+        const glm::vec3& minCorner,
+        const glm::vec3& maxCorner,
+        int resolution,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
+
+    /** Células por eixo para que nenhuma passe de voxelSize em nenhum eixo (ao menos 1 por eixo). */
+    glm::ivec3 CellsForVoxelSize(const glm::vec3& minCorner, const glm::vec3& maxCorner, float voxelSize);
+
+    /** Células por eixo com `resolution` células no eixo mais longo e células (quase) cúbicas nos outros:
+     * um domínio 2 x 2 x 0.6 com resolution 196 vira 196 x 196 x 59, não 196^3. */
+    glm::ivec3 IsotropicCells(const glm::vec3& minCorner, const glm::vec3& maxCorner, int resolution);
+
+    /** @brief Versão genérica, aceita qualquer SDF sem passar por std::function (permite inlining).
+     * O SDF pode ser:
+     *  - um callable float(const glm::vec3&);
+     *  - um objeto com o contrato em lote
+     *    void evaluate(const float* xs, const float* ys, const float* zs, float* out, size_t n) const,
+     *    chamado uma linha da grade por vez;
+     *  - ambos: o lote é usado na grade e o callable nas amostras avulsas (normais).
+     * Se o SDF também tiver glm::vec3 gradient(const glm::vec3&) const, ele atende NormalMode::Analytic. */
+    template<typename SDF>
+    void PolygonizeSurface(const SDF& sdf,
+        const glm::vec3& minCorner,
+        const glm::vec3& maxCorner,
+        int resolution,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
+
+    /** @brief Mesma coisa com o número de células de cada eixo (ver IsotropicCells e CellsForVoxelSize). */
+    template<typename SDF>
+    void PolygonizeSurface(const SDF& sdf,
+        const glm::vec3& minCorner,
+        const glm::vec3& maxCorner,
+        const glm::ivec3& cells,
+        std::vector<float>& outVerts,
+        std::vector<unsigned int>& outIdx,
+        const Settings& settings
+    );
 }
+
+#include "MarchingCubes/PolygonizerDetail.h"
@@ -0,0 +1,1023 @@
+#pragma once
+
+// Implementação dos templates declarados em Polygonizer.h. Não inclua diretamente.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <glm/common.hpp>
+#include <glm/vector_relational.hpp>
+#include <glm/ext/vector_int3.hpp>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#include "MarchingCubes/MarchingCubesTable.h"
+#include "Utility/SIMD/FloatLanes.h"
+
+namespace Polygonizer::Detail
+{
+    /** Resolve Settings::threadCount (0 = todos os núcleos). */
+    unsigned int ResolveThreadCount(unsigned int requested);
+
+    /** Executa job(0..count-1) em até `threads` workers do pool compartilhado e espera todos terminarem. */
+    void ParallelFor(int count, unsigned int threads, const std::function<void(int)>& job);
+
+    // Settings::progress / Settings::cancel de uma chamada. O trabalho é contado em unidades (um plano amostrado, uma
+    // camada marchada); a fração informada só avança, seja qual for a thread que termina uma unidade.
+    class BuildProgress
+    {
+    public:
+        BuildProgress(std::atomic<float>* out, const std::atomic<bool>* cancel, const size_t totalUnits)
+            : m_Out(out), m_Cancel(cancel), m_Total(std::max<size_t>(1, totalUnits)) {}
+
+        bool cancelled() const { return m_Cancel && m_Cancel->load(std::memory_order_relaxed); }
+
+        void advance(const size_t units = 1)
+        {
+            const size_t done = m_Done.fetch_add(units, std::memory_order_relaxed) + units;
+            if (m_Out) m_Out->store(std::min(1.0f, float(done) / float(m_Total)), std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<float>* m_Out;
+        const std::atomic<bool>* m_Cancel;
+        size_t m_Total;
+        std::atomic<size_t> m_Done{ 0 };
+    };
+
+    // Contrato em lote: void evaluate(const float* xs, const float* ys, const float* zs, float* out, size_t n) const
+    template<typename SDF, typename = void>
+    struct HasBatchEvaluate : std::false_type {};
+
+    template<typename SDF>
+    struct HasBatchEvaluate<SDF, std::void_t<decltype(std::declval<const SDF&>().evaluate(
+        std::declval<const float*>(), std::declval<const float*>(), std::declval<const float*>(),
+        std::declval<float*>(), std::declval<size_t>()))>> : std::true_type {};
+
+    // Contrato do gradiente analítico: glm::vec3 gradient(const glm::vec3& p) const
+    template<typename SDF, typename = void>
+    struct HasGradient : std::false_type {};
+
+    template<typename SDF>
+    struct HasGradient<SDF, std::void_t<decltype(glm::vec3(std::declval<const SDF&>().gradient(
+        std::declval<const glm::vec3&>())))>> : std::true_type {};
+
+    // Contrato de intervalo: um objeto com lo/hi que limita o SDF numa caixa (p. ex. SDFProgram::Program::bounds)
+    template<typename SDF, typename = void>
+    struct HasIntervalBounds : std::false_type {};
+
+    template<typename SDF>
+    struct HasIntervalBounds<SDF, std::void_t<decltype(std::declval<const SDF&>().bounds(
+        std::declval<const glm::vec3&>(), std::declval<const glm::vec3&>()).lo)>> : std::true_type {};
+
+    template<typename SDF>
+    constexpr bool IsPointCallable = std::is_invocable_r_v<float, const SDF&, const glm::vec3&>;
+
+    template<typename SDF>
+    float EvaluatePoint(const SDF& sdf, const glm::vec3& p)
+    {
+        static_assert(IsPointCallable<SDF> || HasBatchEvaluate<SDF>::value,
+            "SDF must be callable as float(const glm::vec3&) or provide evaluate(xs, ys, zs, out, n)");
+
+        if constexpr (IsPointCallable<SDF>)
+        {
+            return sdf(p);
+        }
+        else
+        {
+            float out;
+            sdf.evaluate(&p.x, &p.y, &p.z, &out, 1);
+            return out;
+        }
+    }
+
+    // Normal pelo gradiente do SDF, aproximado por diferenças centrais em volta de v.
+    template<typename SDF>
+    glm::vec3 CentralDifferenceNormal(const SDF& sdf, const glm::vec3& v)
+    {
+        const float eps = 1e-3f;
+        if constexpr (IsPointCallable<SDF>)
+        {
+            return glm::normalize(glm::vec3(
+                sdf(v + glm::vec3(eps,0,0)) - sdf(v - glm::vec3(eps,0,0)),
+                sdf(v + glm::vec3(0,eps,0)) - sdf(v - glm::vec3(0,eps,0)),
+                sdf(v + glm::vec3(0,0,eps)) - sdf(v - glm::vec3(0,0,eps))
+            ));
+        }
+        else
+        {
+            // As seis amostras num lote só
+            const float xs[6] = { v.x + eps, v.x - eps, v.x, v.x, v.x, v.x };
+            const float ys[6] = { v.y, v.y, v.y + eps, v.y - eps, v.y, v.y };
+            const float zs[6] = { v.z, v.z, v.z, v.z, v.z + eps, v.z - eps };
+            float d[6];
+            sdf.evaluate(xs, ys, zs, d, 6);
+            return glm::normalize(glm::vec3(d[0] - d[1], d[2] - d[3], d[4] - d[5]));
+        }
+    }
+
+    // Amostra uma linha da grade: out[i] = sdf(xs[i], y, z) para i em [0, count).
+    // SDFs em lote recebem a linha inteira numa chamada; ys/zs são linhas de rascunho com pelo menos `count` floats.
+    template<typename SDF>
+    void SampleRow(const SDF& sdf, const float* xs, const float y, const float z, float* out, const int count,
+        std::vector<float>& ys, std::vector<float>& zs)
+    {
+        if constexpr (HasBatchEvaluate<SDF>::value)
+        {
+            std::fill(ys.begin(), ys.begin() + count, y);
+            std::fill(zs.begin(), zs.begin() + count, z);
+            sdf.evaluate(xs, ys.data(), zs.data(), out, static_cast<size_t>(count));
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+                out[i] = sdf(glm::vec3(xs[i], y, z));
+        }
+    }
+
+    // Gradiente não normalizado no nó (i,j,k) de uma grade de `nodes` nós por eixo: diferenças centrais,
+    // unilaterais nas bordas. planeAt(k) devolve as nodes.x*nodes.y amostras do plano Z k (a grade densa
+    // ou um anel de planos em streaming).
+    template<typename PlaneAt>
+    glm::vec3 GridNodeGradient(const PlaneAt& planeAt, const glm::ivec3& nodes, const int i, const int j, const int k,
+        const float dx, const float dy, const float dz)
+    {
+        auto at = [&](int a, int b, int c) { return planeAt(c)[a + static_cast<size_t>(nodes.x)*b]; };
+        const int i0 = std::max(i-1, 0), i1 = std::min(i+1, nodes.x - 1);
+        const int j0 = std::max(j-1, 0), j1 = std::min(j+1, nodes.y - 1);
+        const int k0 = std::max(k-1, 0), k1 = std::min(k+1, nodes.z - 1);
+        return glm::vec3(
+            (at(i1,j,k) - at(i0,j,k)) / ((i1 - i0) * dx),
+            (at(i,j1,k) - at(i,j0,k)) / ((j1 - j0) * dy),
+            (at(i,j,k1) - at(i,j,k0)) / ((k1 - k0) * dz));
+    }
+
+    template<typename SDF>
+    glm::vec3 AnalyticNormal(const SDF& sdf, const glm::vec3& v)
+    {
+        if constexpr (HasGradient<SDF>::value)
+            return glm::normalize(glm::vec3(sdf.gradient(v)));
+        else
+            return CentralDifferenceNormal(sdf, v);
+    }
+
+    // Cache aresta -> vértice. Com P = nodes.x*nodes.y posições por plano, um plano Z guarda as arestas X nas posições
+    // [0, P) e as arestas Y em [P, 2P), ambas endereçadas por i + nodes.x*j; as arestas Z de uma camada de células usam i + nodes.x*j.
+
+    enum class EdgeStore { Bottom, Top, Layer };
+
+    // Onde fica no cache cada uma das 12 arestas do cubo, e os cantos dela da coordenada menor da grade
+    // para a maior, para toda célula interpolar uma aresta dividida exatamente igual.
+    struct EdgeInfo
+    {
+        EdgeStore store;
+        bool yAxis;
+        int di, dj;
+        int cornerA, cornerB;
+    };
+
+    constexpr EdgeInfo EDGE_INFO[12] = {
+        { EdgeStore::Bottom, false, 0, 0, 0, 1 },
+        { EdgeStore::Bottom, true,  1, 0, 1, 2 },
+        { EdgeStore::Bottom, false, 0, 1, 3, 2 },
+        { EdgeStore::Bottom, true,  0, 0, 0, 3 },
+        { EdgeStore::Top,    false, 0, 0, 4, 5 },
+        { EdgeStore::Top,    true,  1, 0, 5, 6 },
+        { EdgeStore::Top,    false, 0, 1, 7, 6 },
+        { EdgeStore::Top,    true,  0, 0, 4, 7 },
+        { EdgeStore::Layer,  false, 0, 0, 0, 4 },
+        { EdgeStore::Layer,  false, 1, 0, 1, 5 },
+        { EdgeStore::Layer,  false, 1, 1, 2, 6 },
+        { EdgeStore::Layer,  false, 0, 1, 3, 7 },
+    };
+
+    // Grade de cells.x * cells.y * cells.z células, (cells + 1) nós por eixo. O nó n fica em
+    // minCorner + (origin + n) * cellSize; origin é zero, a não ser que a grade seja uma subcaixa de uma rede maior
+    // (Settings::autoBounds): manter o canto da própria rede deixa todo nó, e portanto a malha,
+    // idêntico bit a bit ao da grade inteira.
+    struct Lattice
+    {
+        glm::vec3 minCorner;
+        glm::vec3 cellSize;
+        glm::ivec3 cells;
+        glm::ivec3 origin{ 0 };
+
+        glm::ivec3 nodes() const { return cells + 1; }
+        size_t planeSize() const { return static_cast<size_t>(cells.x + 1) * (cells.y + 1); }
+
+        float coord(const int axis, const int n) const { return minCorner[axis] + float(origin[axis] + n) * cellSize[axis]; }
+        glm::vec3 node(const glm::ivec3& n) const { return minCorner + glm::vec3(origin + n) * cellSize; }
+    };
+
+    // Células agrupadas em blocos de blockSize^3. Blocos descartados comprovadamente não têm superfície e não são
+    // nem amostrados nem marchados; só guardam de que lado da superfície ficam.
+    // Uma execução densa é um único bloco ativo cobrindo a grade inteira.
+    enum BlockState : char { BLOCK_OUTSIDE = 0, BLOCK_ACTIVE = 1, BLOCK_INSIDE = 2 };
+
+    struct BlockGrid
+    {
+        int blockSize = 1;
+        glm::ivec3 count{ 1 };        // blocos por eixo
+        std::vector<char> active;     // BlockState de cada bloco
+
+        size_t index(const int bi, const int bj, const int bk) const
+        {
+            return bi + static_cast<size_t>(count.x)*(bj + static_cast<size_t>(count.y)*bk);
+        }
+
+        bool isActive(const int bi, const int bj, const int bk) const
+        {
+            return active[index(bi, bj, bk)] == BLOCK_ACTIVE;
+        }
+
+        // Blocos cuja faixa de nós, aumentada em `apron` nós, contém o nó n ao longo de `axis`
+        std::pair<int,int> blocksTouchingNode(const int axis, const int n, const int apron) const
+        {
+            const int lo = n - apron - 1 >= 0 ? (n - apron - 1) / blockSize : 0;
+            const int hi = std::min(count[axis] - 1, (n + apron) / blockSize);
+            return { lo, hi };
+        }
+    };
+
+    // Descida em octree sobre faixas de blocos: uma caixa cujo centro está mais longe da superfície que
+    // lipschitz * meia-diagonal não cruza o zero e sai junto com todos os seus blocos.
+    // Retorna o número de avaliações do SDF gastas nos centros das caixas.
+    template<typename SDF>
+    size_t ClassifyBlocks(const SDF& sdf, const Lattice& lattice, const float lipschitz, BlockGrid& blocks)
+    {
+        struct Range { int lo[3]; int hi[3]; };   // índices de bloco, intervalo semiaberto
+        std::vector<Range> stack{ { { 0, 0, 0 }, { blocks.count.x, blocks.count.y, blocks.count.z } } };
+        size_t evaluations = 0;
+
+        while (!stack.empty())
+        {
+            const Range r = stack.back();
+            stack.pop_back();
+
+            glm::vec3 boxMin, boxMax;
+            for (int a = 0; a < 3; ++a)
+            {
+                boxMin[a] = lattice.coord(a, r.lo[a] * blocks.blockSize);
+                boxMax[a] = lattice.coord(a, std::min(r.hi[a] * blocks.blockSize, lattice.cells[a]));
+            }
+            const float halfDiagonal = 0.5f * glm::length(boxMax - boxMin);
+            const float d = EvaluatePoint(sdf, 0.5f * (boxMin + boxMax));
+            ++evaluations;
+
+            // Pequena folga para o arredondamento entre esta amostra e as amostras em lote da grade
+            if (std::abs(d) > lipschitz * halfDiagonal * 1.001f)
+            {
+                if (d < 0.0f)
+                    for (int bk = r.lo[2]; bk < r.hi[2]; ++bk)
+                        for (int bj = r.lo[1]; bj < r.hi[1]; ++bj)
+                            for (int bi = r.lo[0]; bi < r.hi[0]; ++bi)
+                                blocks.active[blocks.index(bi, bj, bk)] = BLOCK_INSIDE;
+                continue;
+            }
+
+            if (r.hi[0] - r.lo[0] == 1 && r.hi[1] - r.lo[1] == 1 && r.hi[2] - r.lo[2] == 1)
+            {
+                blocks.active[blocks.index(r.lo[0], r.lo[1], r.lo[2])] = BLOCK_ACTIVE;
+                continue;
+            }
+
+            // Divide ao meio todo eixo com mais de um bloco
+            int mid[3];
+            for (int a = 0; a < 3; ++a)
+                mid[a] = r.hi[a] - r.lo[a] > 1 ? (r.lo[a] + r.hi[a]) / 2 : r.hi[a];
+            for (int octant = 0; octant < 8; ++octant)
+            {
+                Range child;
+                bool empty = false;
+                for (int a = 0; a < 3; ++a)
+                {
+                    const bool upper = (octant >> a) & 1;
+                    child.lo[a] = upper ? mid[a] : r.lo[a];
+                    child.hi[a] = upper ? r.hi[a] : mid[a];
+                    empty |= child.lo[a] >= child.hi[a];
+                }
+                if (!empty) stack.push_back(child);
+            }
+        }
+        return evaluations;
+    }
+
+    // Caixas-folha do ajuste: folhas menores apertam a caixa em algumas células, mas custam mais amostras
+    constexpr int FIT_LEAF_CELLS = 2;
+
+    // Faixa de células [lo, hi) da grade que pode ter um cruzamento de zero, achada por uma descida em octree sobre
+    // faixas de células até FIT_LEAF_CELLS. Uma caixa sai quando os limites por intervalo excluem o 0 ou, sem eles, quando
+    // |sdf(centro)| > lipschitz * meia-diagonal; caixas já dentro da faixa achada até agora são puladas,
+    // já que não podem aumentá-la. Uma faixa vazia (lo > hi em algum eixo) quer dizer que não há superfície no domínio.
+    // Retorna o número de avaliações do SDF gastas.
+    template<typename SDF>
+    size_t FitSurfaceCells(const SDF& sdf, const Lattice& lattice, const float lipschitz, glm::ivec3& fitLo, glm::ivec3& fitHi)
+    {
+        struct Range { glm::ivec3 lo, hi; };   // índices de célula, intervalo semiaberto
+        std::vector<Range> stack{ { glm::ivec3(0), lattice.cells } };
+        fitLo = lattice.cells;
+        fitHi = glm::ivec3(0);
+        size_t evaluations = 0;
+
+        while (!stack.empty())
+        {
+            const Range r = stack.back();
+            stack.pop_back();
+            if (glm::all(glm::greaterThanEqual(r.lo, fitLo)) && glm::all(glm::lessThanEqual(r.hi, fitHi))) continue;
+
+            const glm::vec3 boxMin = lattice.node(r.lo);
+            const glm::vec3 boxMax = lattice.node(r.hi);
+            bool mayCross;
+            if constexpr (HasIntervalBounds<SDF>::value)
+            {
+                const auto range = sdf.bounds(boxMin, boxMax);
+                mayCross = range.lo <= 0.0f && range.hi >= 0.0f;
+            }
+            else
+            {
+                // Mesma folga de arredondamento do ClassifyBlocks
+                const float d = EvaluatePoint(sdf, 0.5f * (boxMin + boxMax));
+                mayCross = std::abs(d) <= lipschitz * 0.5f * glm::length(boxMax - boxMin) * 1.001f;
+            }
+            ++evaluations;
+            if (!mayCross) continue;
+
+            if (glm::all(glm::lessThanEqual(r.hi - r.lo, glm::ivec3(FIT_LEAF_CELLS))))
+            {
+                fitLo = glm::min(fitLo, r.lo);
+                fitHi = glm::max(fitHi, r.hi);
+                continue;
+            }
+
+            // Divide ao meio todo eixo com mais de uma folha
+            const glm::ivec3 mid = glm::mix(r.hi, (r.lo + r.hi) / 2, glm::greaterThan(r.hi - r.lo, glm::ivec3(FIT_LEAF_CELLS)));
+            for (int octant = 0; octant < 8; ++octant)
+            {
+                Range child;
+                bool empty = false;
+                for (int a = 0; a < 3; ++a)
+                {
+                    const bool upper = (octant >> a) & 1;
+                    child.lo[a] = upper ? mid[a] : r.lo[a];
+                    child.hi[a] = upper ? r.hi[a] : mid[a];
+                    empty |= child.lo[a] >= child.hi[a];
+                }
+                if (!empty) stack.push_back(child);
+            }
+        }
+        return evaluations;
+    }
+
+    // Faixa estreita (adaptativo) ou um único bloco denso. Retorna as avaliações do SDF gastas nos centros das caixas.
+    template<typename SDF>
+    size_t MakeBlockGrid(const SDF& sdf, const Lattice& lattice, const bool adaptive, const int blockSize,
+        const float lipschitz, BlockGrid& blocks)
+    {
+        const int longest = std::max(lattice.cells.x, std::max(lattice.cells.y, lattice.cells.z));
+        if (!adaptive) {
+            blocks.blockSize = longest;
+            blocks.count = glm::ivec3(1);
+            blocks.active.assign(1, BLOCK_ACTIVE);
+            return 0;
+        }
+        blocks.blockSize = std::max(1, std::min(blockSize, longest));
+        blocks.count = (lattice.cells + blocks.blockSize - 1) / blocks.blockSize;
+        blocks.active.assign(static_cast<size_t>(blocks.count.x)*blocks.count.y*blocks.count.z, BLOCK_OUTSIDE);
+        return ClassifyBlocks(sdf, lattice, lipschitz, blocks);
+    }
+
+    /** Acrescenta o espelho dos vértices [firstVertex, fim) e dos triângulos [firstIndex, fim) em torno do plano
+     * (eixo axis) = plane, com a ordem dos triângulos invertida. Vértices sobre o plano não são copiados: as
+     * duas metades os compartilham, e a normal deles perde a componente do eixo. */
+    void MirrorMesh(std::vector<float>& verts, std::vector<unsigned int>& idx, size_t firstVertex, size_t firstIndex,
+        int axis, float plane);
+
+    /** Preenche os nós dos blocos descartados com ±1 conforme o lado da superfície (para quem lê só o sinal da grade). */
+    void FillCulledNodes(const BlockGrid& blocks, const glm::ivec3& cells, std::vector<float>& grid);
+
+    // Amostra as linhas [jBegin, jEnd] do plano Z k em `plane` (linha j em plane + j*nodes.x), só
+    // nos nós dos blocos ativos aumentados em `apron` nós, um trecho contíguo de linha por lote do SDF.
+    // xs guarda as coordenadas X dos nós; ys/zs são linhas de rascunho. Retorna o número de amostras.
+    template<typename SDF>
+    size_t SamplePlaneRows(const SDF& sdf, const float* xs, const Lattice& lattice, const BlockGrid& blocks,
+        const int apron, const int k, const int jBegin, const int jEnd,
+        float* plane, std::vector<float>& ys, std::vector<float>& zs)
+    {
+        const size_t stride = static_cast<size_t>(lattice.cells.x) + 1;
+        size_t samples = 0;
+        const std::pair<int,int> bkSpan = blocks.blocksTouchingNode(2, k, apron);
+        for(int j = jBegin; j <= jEnd; ++j) {
+            const std::pair<int,int> bjSpan = blocks.blocksTouchingNode(1, j, apron);
+
+            // Junta em trechos as faixas de nós em X dos blocos ativos que tocam esta linha
+            int runBegin = -1, runEnd = -1;
+            auto flushRun = [&]() {
+                if (runBegin < 0) return;
+                SampleRow(sdf, xs + runBegin, lattice.coord(1, j), lattice.coord(2, k),
+                    plane + runBegin + stride*j, runEnd - runBegin + 1, ys, zs);
+                samples += static_cast<size_t>(runEnd - runBegin + 1);
+                runBegin = -1;
+            };
+            for(int bi = 0; bi < blocks.count.x; ++bi) {
+                bool touched = false;
+                for(int bk = bkSpan.first; bk <= bkSpan.second && !touched; ++bk)
+                    for(int bj = bjSpan.first; bj <= bjSpan.second && !touched; ++bj)
+                        touched = blocks.isActive(bi, bj, bk);
+                if (!touched) continue;
+
+                const int first = std::max(0, bi*blocks.blockSize - apron);
+                const int last = std::min(lattice.cells.x, (bi+1)*blocks.blockSize + apron);
+                if (runBegin >= 0 && first <= runEnd + 1) {
+                    runEnd = std::max(runEnd, last);
+                } else {
+                    flushRun();
+                    runBegin = first;
+                    runEnd = last;
+                }
+            }
+            flushRun();
+        }
+        return samples;
+    }
+
+    // Amostra os nós da grade dos blocos ativos, aumentados em `apron` nós, um plano Z
+    // por tarefa, avançando `progress` uma unidade por plano. Retorna o número de amostras.
+    template<typename SDF>
+    size_t SampleActiveNodes(const SDF& sdf, const Lattice& lattice, const unsigned int threads, const BlockGrid& blocks,
+        const int apron, std::vector<float>& grid,
+        BuildProgress& progress)
+    {
+        const glm::ivec3 nodes = lattice.nodes();
+        const size_t planeSize = lattice.planeSize();
+
+        std::vector<float> xs(nodes.x);
+        for(int i = 0; i < nodes.x; ++i)
+            xs[i] = lattice.coord(0, i);
+
+        std::vector<size_t> planeSamples(nodes.z, 0);
+        ParallelFor(nodes.z, threads, [&](const int k)
+        {
+            if (progress.cancelled()) return;
+            std::vector<float> ys(nodes.x), zs(nodes.x);
+            planeSamples[k] = SamplePlaneRows(sdf, xs.data(), lattice, blocks, apron,
+                k, 0, lattice.cells.y, &grid[planeSize * k], ys, zs);
+            progress.advance();
+        });
+
+        size_t samples = 0;
+        for(const size_t n : planeSamples) samples += n;
+        return samples;
+    }
+
+    // IDs de vértice das arestas dos planos de nós de baixo e de cima de uma camada de células, mais as arestas Z entre eles.
+    // Toda posição que uma camada lê já foi escrita antes, pelo passe que atribui os IDs, então nada é limpo.
+    struct EdgeCache
+    {
+        std::vector<unsigned int> bottom, top, layer;
+
+        explicit EdgeCache(const size_t planeSlots)
+            : bottom(2 * planeSlots), top(2 * planeSlots), layer(planeSlots) {}
+
+        unsigned int& slot(const EdgeInfo& edge, const size_t node, const size_t planeSlots)
+        {
+            const size_t s = node + (edge.yAxis ? planeSlots : 0);
+            return edge.store == EdgeStore::Bottom ? bottom[s] : edge.store == EdgeStore::Top ? top[s] : layer[s];
+        }
+    };
+
+    // Triângulos de cada caso do cubo, tirados da TRI_TABLE
+    struct TriangleCounts
+    {
+        unsigned char count[256] = {};
+
+        constexpr TriangleCounts()
+        {
+            for (int c = 0; c < 256; ++c) {
+                int t = 0;
+                while (MarchingCubes::TRI_TABLE[c][3 * t] != -1) ++t;
+                count[c] = static_cast<unsigned char>(t);
+            }
+        }
+    };
+    inline constexpr TriangleCounts TRIANGLE_COUNTS{};
+
+    inline int PopCount(uint64_t bits)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int n = 0;
+        for (; bits; bits &= bits - 1) ++n;
+        return n;
+#else
+        return __builtin_popcountll(bits);
+#endif
+    }
+
+    inline int LowestBit(const uint64_t bits)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    // Arestas cujo vértice uma célula cria, para todo cruzamento ter exatamente um dono e os IDs de vértice saírem de
+    // uma soma de prefixos sobre as células: as arestas X e Y no canto menor da face de cima da célula, e a sua aresta Z
+    // de baixo. Células da última coluna ou linha também são donas das arestas da borda da rede daquele lado, e a primeira
+    // camada é dona da face de baixo. Só células ativas são donas de alguma coisa; as outras células que tocam a face de
+    // um bloco descartado não podem ter cruzamento ali.
+    inline int OwnedEdges(const bool lastX, const bool lastY, const bool firstLayer)
+    {
+        int owned = (1 << 4) | (1 << 7) | (1 << 8);
+        if (lastX) owned |= (1 << 5) | (1 << 9);
+        if (lastY) owned |= (1 << 6) | (1 << 11);
+        if (lastX && lastY) owned |= 1 << 10;
+        if (firstLayer) {
+            owned |= (1 << 0) | (1 << 3);
+            if (lastX) owned |= 1 << 1;
+            if (lastY) owned |= 1 << 2;
+        }
+        return owned;
+    }
+
+    // Palavras de uma linha de bits de sinal dos nós
+    inline int SignWords(const int nodesX) { return (nodesX + 63) / 64; }
+
+    // Bit i da linha de palavras j = (nó (i, j) do plano < 0), comparados um registrador SIMD de nós por vez. Os nós
+    // de blocos descartados guardam valores velhos; as células que os leem são mascaradas pelo ClassifyLayer.
+    inline void PlaneSigns(const float* plane, const glm::ivec3& nodes, uint64_t* out)
+    {
+        constexpr int W = SIMD::FloatLanes::Width;
+        const int words = SignWords(nodes.x);
+        for (int j = 0; j < nodes.y; ++j) {
+            const float* row = plane + static_cast<size_t>(nodes.x) * j;
+            uint64_t* bits = out + static_cast<size_t>(words) * j;
+            std::fill(bits, bits + words, uint64_t(0));
+            int i = 0;
+            // W divide 64, então um registrador nunca fica entre duas palavras
+            for (; i + W <= nodes.x; i += W)
+                bits[i >> 6] |= uint64_t(negativeMask(SIMD::FloatLanes::load(row + i))) << (i & 63);
+            for (; i < nodes.x; ++i)
+                if (row[i] < 0.0f) bits[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+
+    // Célula com cruzamento de zero: i + cells.x * j dentro da sua camada, e o seu caso do cubo
+    struct ActiveCell
+    {
+        unsigned int cell;
+        unsigned char cube;
+    };
+
+    // Saída do passe 1 para uma camada de células: as células ativas compactadas e o que elas vão emitir
+    struct LayerCells
+    {
+        std::vector<ActiveCell> cells;
+        size_t vertexCount = 0;
+        size_t triangleCount = 0;
+    };
+
+    // Passe 1: casos do cubo da camada de células entre os planos de nós k e k+1 a partir dos bits de sinal, 64 células
+    // por passo. Uma célula é pulada quando os oito cantos concordam, o que se acha com ANDs e ORs de palavras inteiras;
+    // só as mistas (poucos por cento) são visitadas, e cada uma soma os seus cruzamentos e triângulos às contagens da camada.
+    inline void ClassifyLayer(const uint64_t* lowerSigns, const uint64_t* upperSigns, const int k, const Lattice& lattice,
+        const BlockGrid& blocks, LayerCells& out)
+    {
+        const glm::ivec3& cells = lattice.cells;
+        const int words = SignWords(cells.x + 1);
+        const int cellWords = (cells.x + 63) / 64;
+        out.cells.clear();
+        out.vertexCount = out.triangleCount = 0;
+
+        // Células dos blocos ativos na linha de blocos atual; uma execução densa tem um bloco cobrindo tudo
+        std::vector<uint64_t> blockMask(cellWords);
+        int maskRow = -1;
+        const int bk = k / blocks.blockSize;
+
+        for (int j = 0; j < cells.y; ++j) {
+            const int bj = j / blocks.blockSize;
+            if (bj != maskRow) {
+                maskRow = bj;
+                std::fill(blockMask.begin(), blockMask.end(), uint64_t(0));
+                for (int bi = 0; bi < blocks.count.x; ++bi) {
+                    if (!blocks.isActive(bi, bj, bk)) continue;
+                    const int end = std::min(cells.x, (bi + 1) * blocks.blockSize);
+                    for (int i = bi * blocks.blockSize; i < end; ++i) blockMask[i >> 6] |= uint64_t(1) << (i & 63);
+                }
+            }
+
+            const uint64_t* rows[4] = {
+                lowerSigns + static_cast<size_t>(words) * j, lowerSigns + static_cast<size_t>(words) * (j + 1),
+                upperSigns + static_cast<size_t>(words) * j, upperSigns + static_cast<size_t>(words) * (j + 1)
+            };
+            for (int w = 0; w < cellWords; ++w) {
+                // O canto c da célula 64w+b é o bit b de corner[c]: a própria linha de nós ou deslocada em um nó
+                auto shifted = [&](const uint64_t* r) { return (r[w] >> 1) | (w + 1 < words ? r[w + 1] << 63 : 0); };
+                const uint64_t corner[8] = {
+                    rows[0][w], shifted(rows[0]), shifted(rows[1]), rows[1][w],
+                    rows[2][w], shifted(rows[2]), shifted(rows[3]), rows[3][w]
+                };
+                uint64_t all = ~uint64_t(0), any = 0;
+                for (const uint64_t c : corner) {
+                    all &= c;
+                    any |= c;
+                }
+                const int validBits = std::min(64, cells.x - 64 * w);
+                const uint64_t valid = validBits == 64 ? ~uint64_t(0) : (uint64_t(1) << validBits) - 1;
+                uint64_t mixed = any & ~all & valid & blockMask[w];
+
+                for (; mixed; mixed &= mixed - 1) {
+                    const int b = LowestBit(mixed);
+                    int cube = 0;
+                    for (int c = 0; c < 8; ++c) cube |= static_cast<int>((corner[c] >> b) & 1u) << c;
+
+                    const int i = 64 * w + b;
+                    const int owned = OwnedEdges(i == cells.x - 1, j == cells.y - 1, k == 0);
+                    out.cells.push_back({ static_cast<unsigned int>(i + cells.x * j), static_cast<unsigned char>(cube) });
+                    out.vertexCount += static_cast<size_t>(PopCount(uint64_t(MarchingCubes::EDGE_TABLE[cube] & owned)));
+                    out.triangleCount += TRIANGLE_COUNTS.count[cube];
+                }
+            }
+        }
+    }
+
+    // Numera os cruzamentos das células da camada k, na ordem das células e depois das arestas, a partir de
+    // firstVertex, e os registra em `edges` (plano de cima e arestas Z). Com `verts`, também escreve cada vértice
+    // (posição + normal, UV 0) no seu ID, 8 floats por vértice; sem, só os IDs são refeitos, para uma fatia
+    // que começa acima da camada.
+    template<typename SDF, typename PlaneAt>
+    void AssignLayerVertices(const SDF& sdf, const PlaneAt& planeAt, const int k, const Lattice& lattice, const NormalMode normalMode,
+        const LayerCells& layer, unsigned int firstVertex, EdgeCache& edges, float* verts)
+    {
+        const glm::ivec3 nodes = lattice.nodes();
+        const size_t stride = static_cast<size_t>(nodes.x);
+        const size_t planeSlots = lattice.planeSize();
+        const float* lower = planeAt(k);
+        const float* upper = planeAt(k + 1);
+        unsigned int next = firstVertex;
+
+        for (const ActiveCell& active : layer.cells) {
+            const int i = static_cast<int>(active.cell % static_cast<unsigned int>(lattice.cells.x));
+            const int j = static_cast<int>(active.cell / static_cast<unsigned int>(lattice.cells.x));
+            int owned = MarchingCubes::EDGE_TABLE[active.cube] & OwnedEdges(i == lattice.cells.x - 1, j == lattice.cells.y - 1, k == 0);
+            if (!owned) continue;
+
+            const size_t node = static_cast<size_t>(i) + stride * static_cast<size_t>(j);
+            const float val[8] = {
+                lower[node], lower[node + 1], lower[node + 1 + stride], lower[node + stride],
+                upper[node], upper[node + 1], upper[node + 1 + stride], upper[node + stride]
+            };
+
+            for (; owned; owned &= owned - 1) {
+                const int e = LowestBit(static_cast<uint64_t>(owned));
+                const EdgeInfo& edge = EDGE_INFO[e];
+                const unsigned int id = next++;
+                edges.slot(edge, static_cast<size_t>(i + edge.di) + stride * static_cast<size_t>(j + edge.dj), planeSlots) = id;
+                if (!verts) continue;
+
+                auto cornerNode = [&](const int c)
+                {
+                    int xi = i + ((c==1||c==2||c==5||c==6)?1:0);
+                    int yj = j + ((c>=2&&c<=3)||(c>=6&&c<=7)?1:0);
+                    int zk = k + (c>=4?1:0);
+                    return glm::ivec3(xi, yj, zk);
+                };
+                const glm::ivec3 nodeA = cornerNode(edge.cornerA);
+                const glm::ivec3 nodeB = cornerNode(edge.cornerB);
+                const glm::vec3 pA = lattice.node(nodeA);
+                const glm::vec3 pB = lattice.node(nodeB);
+
+                // Interpolação linear ao longo da aresta
+                const float t = val[edge.cornerA] / (val[edge.cornerA] - val[edge.cornerB]);
+                glm::vec3 v = pA + t * (pB - pA);
+
+                glm::vec3 n;
+                if (normalMode == NormalMode::GridGradient) {
+                    const glm::vec3& cellSize = lattice.cellSize;
+                    const glm::vec3 g = glm::mix(
+                        GridNodeGradient(planeAt, nodes, nodeA.x, nodeA.y, nodeA.z, cellSize.x, cellSize.y, cellSize.z),
+                        GridNodeGradient(planeAt, nodes, nodeB.x, nodeB.y, nodeB.z, cellSize.x, cellSize.y, cellSize.z), t);
+                    // Pontos planos da grade (p. ex. uma parede fina amostrada num só nó) não têm gradiente utilizável
+                    n = glm::dot(g, g) > 1e-12f ? glm::normalize(g) : CentralDifferenceNormal(sdf, v);
+                }
+                else if (normalMode == NormalMode::Analytic)
+                    n = AnalyticNormal(sdf, v);
+                else
+                    n = CentralDifferenceNormal(sdf, v);
+
+                // pos(xyz), normal(xyz), UV(0,0)
+                float* out = verts + static_cast<size_t>(id) * 8;
+                out[0] = v.x; out[1] = v.y; out[2] = v.z;
+                out[3] = n.x; out[4] = n.y; out[5] = n.z;
+                out[6] = 0.0f; out[7] = 0.0f;
+            }
+        }
+    }
+
+    // Passe 2, triângulos de uma camada: toda aresta que eles usam já tem o seu ID em `edges` (o plano de baixo vem da
+    // camada de baixo, o resto do AssignLayerVertices). Escreve 3 * layer.triangleCount índices em `idx`; na volta
+    // edges.bottom guarda as arestas do seu plano de cima, pronto para a próxima camada.
+    inline void EmitLayerTriangles(const Lattice& lattice, const bool invertFaceSide, const LayerCells& layer,
+        EdgeCache& edges, unsigned int* idx)
+    {
+        const size_t stride = static_cast<size_t>(lattice.cells.x) + 1;
+        const size_t planeSlots = lattice.planeSize();
+
+        for (const ActiveCell& active : layer.cells) {
+            const size_t i = active.cell % static_cast<unsigned int>(lattice.cells.x);
+            const size_t j = active.cell / static_cast<unsigned int>(lattice.cells.x);
+            auto edgeVertex = [&](const int e)
+            {
+                const EdgeInfo& edge = EDGE_INFO[e];
+                return edges.slot(edge, (i + edge.di) + stride * (j + edge.dj), planeSlots);
+            };
+
+            const int* tri = MarchingCubes::TRI_TABLE[active.cube];
+            for (int t = 0; tri[t] != -1; t += 3) {
+                const unsigned int a = edgeVertex(tri[t]);
+                const unsigned int b = edgeVertex(tri[t + 1]);
+                const unsigned int c = edgeVertex(tri[t + 2]);
+                idx[0] = a;
+                idx[1] = invertFaceSide ? b : c;
+                idx[2] = invertFaceSide ? c : b;
+                idx += 3;
+            }
+        }
+
+        std::swap(edges.bottom, edges.top);
+    }
+
+    // PolygonizeSurface nos nós de `lattice`; o Settings::autoBounds já foi resolvido por quem chama.
+    template<typename SDF>
+    void PolygonizeLattice(const SDF& sdf, const Lattice& lattice,
+        std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+    {
+        const unsigned int threads = ResolveThreadCount(settings.threadCount);
+
+        const auto sampleStart = std::chrono::steady_clock::now();
+
+        // 0) Faixa estreita: no modo adaptativo só ficam ativos os blocos que podem atravessar a superfície
+        BlockGrid blocks;
+        const size_t boundEvaluations = MakeBlockGrid(sdf, lattice,
+            settings.adaptive, settings.blockSize, settings.lipschitz, blocks);
+        // As normais da grade leem um nó além da borda, então os blocos ativos são amostrados com uma margem de 1 nó
+        const int apron = settings.normalMode == NormalMode::GridGradient ? 1 : 0;
+
+        const glm::ivec3 nodes = lattice.nodes();
+        const int layers = lattice.cells.z;
+        const size_t planeSize = lattice.planeSize();
+        size_t gridSamples = 0;
+        double sampleMs = 0.0, extractMs = 0.0;
+        // Uma unidade por plano amostrado e uma por camada marchada
+        BuildProgress progress(settings.progress, settings.cancel, static_cast<size_t>(nodes.z) + layers);
+        auto msSince = [](const std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        const int words = SignWords(nodes.x);
+        const size_t signPlane = static_cast<size_t>(words) * nodes.y;
+        size_t activeCells = 0;
+
+        if (settings.streaming) {
+            // 1+2) Um plano Z por vez: o plano k+1 é amostrado (linhas divididas entre as threads), depois a camada de
+            //      células entre k e k+1 é classificada e marchada direto para a saída. Só os planos que uma camada lê
+            //      ficam vivos: k e k+1, mais k-1 e k+2 para as normais da grade. Os IDs de vértice seguem a mesma
+            //      ordem de células do caminho denso, então a saída é a mesma.
+            const int ringSize = 2 + 2 * apron;
+            std::vector<float> ring(planeSize * ringSize);
+            auto planeAt = [&](const int k) -> const float* { return &ring[planeSize * (k % ringSize)]; };
+            std::vector<uint64_t> signRing(2 * signPlane);
+            auto signsAt = [&](const int k) { return &signRing[signPlane * (k % 2)]; };
+
+            std::vector<float> xs(nodes.x);
+            for(int i = 0; i < nodes.x; ++i)
+                xs[i] = lattice.coord(0, i);
+            const int rowChunks = std::max(1, std::min(nodes.y, static_cast<int>(threads) * 4));
+            std::vector<size_t> chunkSamples(rowChunks);
+            auto samplePlane = [&](const int k)
+            {
+                float* plane = &ring[planeSize * (k % ringSize)];
+                ParallelFor(rowChunks, threads, [&](const int c)
+                {
+                    std::vector<float> ys(nodes.x), zs(nodes.x);
+                    chunkSamples[c] += SamplePlaneRows(sdf, xs.data(), lattice, blocks, apron,
+                        k, nodes.y * c / rowChunks, nodes.y * (c + 1) / rowChunks - 1, plane, ys, zs);
+                });
+            };
+
+            // Os triângulos vão direto para a saída; uma chamada cancelada a devolve para onde começou
+            const size_t vertsBefore = outVerts.size(), idxBefore = outIdx.size();
+            EdgeCache edges(planeSize);
+            LayerCells layer;
+            for(int k = 0; k <= std::min(apron, layers); ++k) {
+                samplePlane(k);
+                progress.advance();
+            }
+            PlaneSigns(planeAt(0), nodes, signsAt(0));
+            sampleMs = msSince(sampleStart);
+            for(int k = 0; k < layers; ++k) {
+                if (progress.cancelled()) {
+                    outVerts.resize(vertsBefore);
+                    outIdx.resize(idxBefore);
+                    return;
+                }
+
+                // Amostragem e marcha se alternam; o tempo de cada lado é acumulado
+                const auto planeStart = std::chrono::steady_clock::now();
+                if (k + 1 + apron <= layers) samplePlane(k + 1 + apron);
+                const auto layerStart = std::chrono::steady_clock::now();
+                sampleMs += std::chrono::duration<double, std::milli>(layerStart - planeStart).count();
+
+                PlaneSigns(planeAt(k + 1), nodes, signsAt(k + 1));
+                ClassifyLayer(signsAt(k), signsAt(k + 1), k, lattice, blocks, layer);
+                activeCells += layer.cells.size();
+
+                const size_t firstVertex = outVerts.size() / 8, firstIndex = outIdx.size();
+                outVerts.resize(outVerts.size() + 8 * layer.vertexCount);
+                outIdx.resize(outIdx.size() + 3 * layer.triangleCount);
+                AssignLayerVertices(sdf, planeAt, k, lattice, settings.normalMode, layer,
+                    static_cast<unsigned int>(firstVertex), edges, outVerts.data());
+                EmitLayerTriangles(lattice, settings.invertFaceSide, layer, edges, outIdx.data() + firstIndex);
+                extractMs += msSince(layerStart);
+                progress.advance(k + 1 + apron <= layers ? 2 : 1);
+            }
+            for(const size_t n : chunkSamples) gridSamples += n;
+        }
+        else {
+            // 1) Amostra o SDF nos nós da grade dos blocos ativos
+            std::vector<float> grid(planeSize * nodes.z);
+            auto planeAt = [&](const int k) -> const float* { return &grid[planeSize * k]; };
+            gridSamples = SampleActiveNodes(sdf, lattice, threads, blocks, apron, grid, progress);
+            if (progress.cancelled()) return;
+
+            sampleMs = msSince(sampleStart);
+            const auto extractStart = std::chrono::steady_clock::now();
+
+            // 2) Passe 1, em paralelo: bits de sinal de todo plano de nós, depois a lista compactada das células com
+            //    cruzamento em cada camada, com os vértices e triângulos que cada uma vai emitir
+            std::vector<uint64_t> signs(signPlane * nodes.z);
+            ParallelFor(nodes.z, threads, [&](const int k)
+            {
+                PlaneSigns(planeAt(k), nodes, &signs[signPlane * k]);
+            });
+            std::vector<LayerCells> layerCells(layers);
+            ParallelFor(layers, threads, [&](const int k)
+            {
+                ClassifyLayer(&signs[signPlane * k], &signs[signPlane * (k + 1)], k, lattice, blocks, layerCells[k]);
+            });
+
+            // 3) Soma de prefixos sobre as camadas: onde começam os vértices e índices de cada uma. A saída cresce uma
+            //    vez só, até o tamanho exato, e cada camada escreve no seu próprio trecho
+            std::vector<size_t> firstVertex(layers + 1), firstIndex(layers + 1);
+            const size_t vertsBefore = outVerts.size(), idxBefore = outIdx.size();
+            firstVertex[0] = vertsBefore / 8;
+            firstIndex[0] = idxBefore;
+            for(int k = 0; k < layers; ++k) {
+                firstVertex[k + 1] = firstVertex[k] + layerCells[k].vertexCount;
+                firstIndex[k + 1] = firstIndex[k] + 3 * layerCells[k].triangleCount;
+                activeCells += layerCells[k].cells.size();
+            }
+            outVerts.resize(8 * firstVertex[layers]);
+            outIdx.resize(firstIndex[layers]);
+
+            // 4) Passe 2 em fatias Z: vértices, depois triângulos, camada por camada. Os IDs vêm da soma de prefixos, não
+            //    da fatia, então a saída é a mesma com qualquer número de threads
+            const int slabCount = std::max(1, std::min(layers, static_cast<int>(threads) * 4));
+            ParallelFor(slabCount, threads, [&](const int s)
+            {
+                const int kBegin = layers * s / slabCount;
+                const int kEnd   = layers * (s + 1) / slabCount;
+
+                // O plano de baixo de uma fatia acima de k=0 foi numerado pela camada de baixo: só os IDs dele são refeitos
+                EdgeCache edges(planeSize);
+                if (kBegin > 0) {
+                    AssignLayerVertices(sdf, planeAt, kBegin - 1, lattice, settings.normalMode, layerCells[kBegin - 1],
+                        static_cast<unsigned int>(firstVertex[kBegin - 1]), edges, nullptr);
+                    std::swap(edges.bottom, edges.top);
+                }
+
+                for(int k = kBegin; k < kEnd && !progress.cancelled(); ++k) {
+                    AssignLayerVertices(sdf, planeAt, k, lattice, settings.normalMode, layerCells[k],
+                        static_cast<unsigned int>(firstVertex[k]), edges, outVerts.data());
+                    EmitLayerTriangles(lattice, settings.invertFaceSide, layerCells[k], edges, outIdx.data() + firstIndex[k]);
+                    progress.advance();
+                }
+            });
+            if (progress.cancelled()) {
+                outVerts.resize(vertsBefore);
+                outIdx.resize(idxBefore);
+                return;
+            }
+            extractMs = msSince(extractStart);
+        }
+
+        if (settings.stats) {
+            Stats& stats = *settings.stats;
+            stats.gridSamples = gridSamples;
+            stats.boundSamples = boundEvaluations;
+            stats.totalBlocks = blocks.active.size();
+            stats.activeBlocks = static_cast<size_t>(std::count(blocks.active.begin(), blocks.active.end(), BLOCK_ACTIVE));
+            stats.sampleMs = sampleMs;
+            stats.extractMs = extractMs;
+            stats.fitSamples = stats.savedSamples = 0;
+            stats.mirroredVertices = 0;
+            stats.activeCells = activeCells;
+            stats.fittedMin = lattice.node(glm::ivec3(0));
+            stats.fittedMax = lattice.node(lattice.cells);
+        }
+    }
+}
+
+template<typename SDF>
+void Polygonizer::PolygonizeSurface(const SDF& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    int resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    PolygonizeSurface(sdf, minCorner, maxCorner, glm::ivec3(resolution), outVerts, outIdx, settings);
+}
+
+template<typename SDF>
+void Polygonizer::PolygonizeSurface(const SDF& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    const glm::ivec3& cells, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    using namespace Polygonizer::Detail;
+
+    const Lattice lattice{ minCorner, (maxCorner - minCorner) / glm::vec3(cells), cells };
+
+    // Planos de simetria: poligoniza a região acima de cada plano, com o plano como o seu primeiro plano de nós,
+    // depois espelha a malha em cada plano, um de cada vez
+    if (glm::any(settings.symmetry)) {
+        glm::vec3 halfMin = minCorner, halfMax = maxCorner;
+        glm::ivec3 halfCells = cells;
+        for (int a = 0; a < 3; ++a) {
+            if (!settings.symmetry[a]) continue;
+            const float plane = settings.symmetryPlane[a];
+            // O lado mais distante do domínio define o alcance, para a caixa espelhada cobrir o domínio inteiro
+            const float reach = std::max(maxCorner[a] - plane, plane - minCorner[a]);
+            halfCells[a] = std::max(1, static_cast<int>(std::ceil(reach / lattice.cellSize[a] - 1e-4f)));
+            halfMin[a] = plane;
+            halfMax[a] = plane + float(halfCells[a]) * lattice.cellSize[a];
+        }
+
+        Settings half = settings;
+        half.symmetry = glm::bvec3(false);
+        const size_t firstVertex = outVerts.size() / 8, firstIndex = outIdx.size();
+        PolygonizeSurface(sdf, halfMin, halfMax, halfCells, outVerts, outIdx, half);
+        // Uma chamada cancelada deixa a saída como a encontrou, não com meia malha
+        if (settings.cancel && settings.cancel->load(std::memory_order_relaxed)) {
+            outVerts.resize(8 * firstVertex);
+            outIdx.resize(firstIndex);
+            return;
+        }
+
+        const size_t halfVertices = outVerts.size() / 8;
+        for (int a = 0; a < 3; ++a)
+            if (settings.symmetry[a])
+                MirrorMesh(outVerts, outIdx, firstVertex, firstIndex, a, settings.symmetryPlane[a]);
+        if (settings.stats) settings.stats->mirroredVertices = outVerts.size() / 8 - halfVertices;
+        return;
+    }
+
+    if (!settings.autoBounds) {
+        PolygonizeLattice(sdf, lattice, outVerts, outIdx, settings);
+        return;
+    }
+
+    // Encolhe o domínio para as células em volta da superfície: uma subcaixa da mesma rede, então os nós
+    // (e a malha) continuam os mesmos
+    glm::ivec3 lo, hi;
+    const size_t fitEvaluations = FitSurfaceCells(sdf, lattice, settings.lipschitz, lo, hi);
+    const auto denseSamples = [](const glm::ivec3& n) { return size_t(n.x + 1) * size_t(n.y + 1) * size_t(n.z + 1); };
+
+    if (glm::any(glm::greaterThanEqual(lo, hi))) {
+        // Nenhum cruzamento de zero: a grade inteira também não emitiria nenhum triângulo
+        if (settings.stats) {
+            *settings.stats = Stats{};
+            settings.stats->fitSamples = fitEvaluations;
+            settings.stats->savedSamples = denseSamples(cells);
+            settings.stats->fittedMin = settings.stats->fittedMax = minCorner;
+        }
+        if (settings.progress) settings.progress->store(1.0f, std::memory_order_relaxed);
+        return;
+    }
+
+    lo = glm::max(lo - settings.autoBoundsPadding, glm::ivec3(0));
+    hi = glm::min(hi + settings.autoBoundsPadding, cells);
+    PolygonizeLattice(sdf, Lattice{ minCorner, lattice.cellSize, hi - lo, lo }, outVerts, outIdx, settings);
+
+    if (settings.stats) {
+        settings.stats->fitSamples = fitEvaluations;
+        settings.stats->savedSamples = denseSamples(cells) - denseSamples(hi - lo);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshOptimization
+{
+    /** Eficiência do cache de vértices pós-transformação, simulado como FIFO. */
+    struct CacheStats
+    {
+        /** Vértices transformados por triângulo (ACMR): 3 sem reuso nenhum, perto de 0,5 no ideal de uma grade. */
+        float acmr = 0.0f;
+        /** Vértices transformados por vértice da malha (ATVR): 1 é o ideal, cada vértice transformado uma vez só. */
+        float atvr = 0.0f;
+    };
+
+    /** Contadores de uma chamada, preenchidos quando Settings::stats aponta para eles. */
+    struct Stats
+    {
+        CacheStats before;
+        CacheStats after;
+        /** Blocos de triângulos ordenados para o overdraw. */
+        size_t clusters = 0;
+        double ms = 0.0;
+    };
+
+    /** Opções da otimização. */
+    struct Settings
+    {
+        /** Tamanho do cache de vértices para o qual a ordem é feita (e com o qual as estatísticas são medidas). */
+        unsigned int cacheSize = 16;
+
+        /** Os blocos ordenados para o overdraw são cortados onde o ACMR acumulado do bloco fica abaixo de
+         * threshold vezes o ACMR do bloco inteiro: 1,05 aceita até 5% de perda no cache em troca de blocos menores,
+         * que se ordenam melhor. 0 desliga a ordenação para o overdraw. */
+        float overdrawThreshold = 1.05f;
+
+        Stats* stats = nullptr;
+    };
+
+    /** @brief Simula um cache FIFO de cacheSize vértices sobre os índices. */
+    CacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize);
+
+    /** @brief Reordena a malha para a GPU, no formato de saída do Polygonizer: pos(3), normal(3), UV(2) e índices.
+     * A geometria não muda, só a ordem:
+     *  1. Triângulos na ordem do Tipsify (Sander, Nehab e Barczak 2007), que segue os vizinhos dos vértices que
+     *     ainda estão no cache em vez da ordem de varredura da grade.
+     *  2. Blocos dessa ordem ordenados para reduzir o overdraw: os que ficam mais para fora da malha, na direção
+     *     da própria normal, vão primeiro e tampam os de dentro.
+     *  3. Vértices renumerados na ordem em que os índices os usam pela primeira vez, para a leitura do VBO ser
+     *     sequencial. Vértices que nenhum triângulo usa saem. */
+    void OptimizeMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, const Settings& settings);
+}
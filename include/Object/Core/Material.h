@@ -6,26 +6,33 @@
 #include "texture.h"
 #include "glad/glad.h"
 
+/** Shader, textura e cor de um objeto. O programa e a textura vêm dos registros (ShaderRegistry e TextureRegistry),
+ * então copiar um Material só copia referências: todos os Materials padrão usam o mesmo programa e a mesma imagem. */
 struct Material
 {
     Shader shader;
     Texture diffuseMap;
     glm::vec3 diffuseColor{ 1.f, 1.f, 1.f };
+    /** Desenhado com blending, depois dos opacos e de trás para frente (RenderQueue). */
+    bool transparent = false;
 
     explicit Material()
         : shader(std::string("Shaders/default.vs").c_str(), std::string("Shaders/default.fs").c_str()), diffuseMap()
     {
         diffuseMap.load("textures/metal_texture.jpg");
+        resolveUniforms();
     }
     explicit Material(const std::string& texturePath)
         : shader(std::string("Shaders/default.vs").c_str(), std::string("Shaders/default.fs").c_str()), diffuseMap()
     {
         diffuseMap.load(texturePath);
+        resolveUniforms();
     }
     Material(const std::string& vsPath, const std::string& fsPath, const std::string& texturePath)
         : shader(vsPath.c_str(), fsPath.c_str()), diffuseMap()
     {
         diffuseMap.load(texturePath);
+        resolveUniforms();
     }
 
     void bind()
@@ -33,20 +40,29 @@ struct Material
         shader.use();
 
         // 1) bind da textura na unit 0
-        glActiveTexture(GL_TEXTURE0);
-        diffuseMap.bind();
-        shader.setInt("material.diffuse", 0);
+        diffuseMap.bind(0);
+        shader.set(uDiffuse, 0);
 
         // 2) seta a shininess que o shader espera
-        GLint locShine = glGetUniformLocation(shader.ID, "material.shininess");
-        if (locShine >= 0) {
-            glUniform1f(locShine, /* por exemplo */ 32.0f);
-        }
+        shader.set(uShininess, /* por exemplo */ 32.0f);
 
-        shader.setVec3("material.diffuseColor", diffuseColor);
+        shader.set(uDiffuseColor, diffuseColor);
     }
 
     std::string getTexturePath() const { return diffuseMap.getFilePath(); }
     std::string getVertexShaderPath() const { return shader.getVertexPath(); }
     std::string getFragmentShaderPath() const { return shader.getFragmentPath(); }
+
+private:
+    // Uniforms do bind, resolvidos uma vez para o programa do shader
+    Shader::Uniform<int> uDiffuse;
+    Shader::Uniform<float> uShininess;
+    Shader::Uniform<glm::vec3> uDiffuseColor;
+
+    void resolveUniforms()
+    {
+        uDiffuse = shader.uniform<int>("material.diffuse");
+        uShininess = shader.uniform<float>("material.shininess");
+        uDiffuseColor = shader.uniform<glm::vec3>("material.diffuseColor");
+    }
 };
@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <glm/glm.hpp>
 #include <glm/geometric.hpp>
-#include <algorithm>
 #include <vector>
 
+#include "Utility/Math/Dual3.h"
+#include "Utility/Math/GenericVec3.h"
+#include "Utility/SIMD/FloatLanes.h"
+
 /** Constructive Solid Geometry Implementable */
 class CSGImplementable
 {
@@ -210,6 +213,221 @@ protected:
         return std::max(dist2D, dy);
     }
     
+    /** Rotaciona p em torno do eixo Z (ângulo em graus). */
+    static glm::vec3 rotateZ(const glm::vec3& p, const float angleDeg)
+    {
+        const float a = glm::radians(angleDeg);
+        const float ca = std::cos(a), sa = std::sin(a);
+        return { p.x * ca - p.y * sa, p.x * sa + p.y * ca, p.z };
+    }
+
+    // ————————————————————————————————————————————————————————————————
+    //  Versões genéricas (SoA) das primitivas e combinadores acima.
+    //  S é um escalar "float-like" — SIMD::FloatLanes, que avalia FloatLanes::Width pontos de uma
+    //  vez, ou MathUtils::Dual3, que devolve distância e gradiente numa só avaliação. A matemática
+    //  é a mesma das versões escalares, o que permite escrever o SDF de um glifo uma vez só como
+    //  template do tipo do ponto.
+    // ————————————————————————————————————————————————————————————————
+    template<typename S>
+    using SoAVec3 = MathUtils::GenericVec3<S>;
+
+    template<typename S>
+    static S opUnion(const S& a, const S& b) {
+        using std::min;
+        return min(a, b);
+    }
+
+    template<typename S>
+    static S opIntersection(const S& a, const S& b) {
+        using std::max;
+        return max(a, b);
+    }
+
+    template<typename S>
+    static S opSubtract(const S& a, const S& b) {
+        using std::max;
+        return max(a, -b);
+    }
+
+    template<typename S>
+    static SoAVec3<S> rotateZ(const SoAVec3<S>& p, const float angleDeg)
+    {
+        const float a = glm::radians(angleDeg);
+        const float ca = std::cos(a), sa = std::sin(a);
+        return { p.x * ca - p.y * sa, p.x * sa + p.y * ca, p.z };
+    }
+
+    template<typename S>
+    static S planeSDF(const SoAVec3<S>& p, const glm::vec3& n, const float offset)
+    {
+        return dot(p, n) - offset;
+    }
+
+    template<typename S>
+    static S boxSDF(const SoAVec3<S>& p, const glm::vec3& b)
+    {
+        using std::min; using std::max;
+        const SoAVec3<S> d = abs(p) - b;
+        return length(max(d, 0.0f)) + min(max(d.x, max(d.y, d.z)), S(0.0f));
+    }
+
+    template<typename S>
+    static S rotatedRightTriangleSDF(
+    const SoAVec3<S>& p, const glm::vec2& baseXZ, const float heightY, const float angleDeg = 0.0f)
+    {
+        using std::max; using std::abs;
+        const float a = glm::radians(angleDeg);
+        const float ca = std::cos(a), sa = std::sin(a);
+        const S qx = p.x * ca - p.z * sa;
+        const S qz = p.x * sa + p.z * ca;
+
+        const S dY = abs(p.y) - heightY * 0.5f;
+
+        const float slope = baseXZ.y / baseXZ.x;
+        const S d2D = max(max(-qx, -qz), qz + qx * slope - baseXZ.y);
+        return max(d2D, dY);
+    }
+
+    template<typename S>
+    static S rightTrianglePrismSDF(const SoAVec3<S>& p, const glm::vec2& baseXZ, const float heightY)
+    {
+        using std::max; using std::abs;
+        const S dY = abs(p.y) - heightY * 0.5f;
+
+        const float ratio = baseXZ.y / baseXZ.x;
+        const S d2D = max(max(-p.x, -p.z), p.z + p.x * ratio - baseXZ.y);
+        return max(d2D, dY);
+    }
+
+    template<typename S>
+    static S boxExtrudedSDF(const SoAVec3<S>& p, const float hx, const float hz, const float heightY)
+    {
+        using std::min; using std::max; using std::abs;
+        const SoAVec3<S> q(abs(p.x), p.y, abs(p.z));
+        const SoAVec3<S> d = q - glm::vec3(hx, heightY, hz);
+
+        const S outside = length(max(d, 0.0f));
+        const S inside  = min(max(d.x, max(d.y, d.z)), S(0.0f));
+        return outside + inside;
+    }
+
+    template<typename S>
+    static S cappedCylinderSDF(const SoAVec3<S>& p, const glm::vec3& a, const glm::vec3& b, const float r)
+    {
+        using std::max;
+        const glm::vec3 ba = b - a;
+        const float len = glm::length(ba);
+        const glm::vec3 baN = ba / len;
+        const SoAVec3<S> pa = p - a;
+
+        const S t = dot(pa, baN);
+        const S dCyl = length(pa - SoAVec3<S>(baN) * t) - r;
+        const S dCap = max(t - len, -t);
+        return max(dCyl, dCap);
+    }
+
+    template<typename S>
+    static S quarterCylinderSDF(
+        const SoAVec3<S> &p,
+        const glm::vec3 &a,
+        const glm::vec3 &b,
+        float            r,
+        const glm::vec3 &n1, float off1,
+        const glm::vec3 &n2, float off2
+    ){
+        using std::max;
+        const S dCyl = cappedCylinderSDF(p, a, b, r);
+        return max(dCyl, max(planeSDF(p, n1, off1), planeSDF(p, n2, off2)));
+    }
+
+    template<typename S>
+    static S slopePlaneSDF(const SoAVec3<S>& p, const float hx, const float heightY)
+    {
+        const glm::vec3 n = glm::normalize(glm::vec3(heightY, -hx, 0.0f));
+        const float c     = glm::dot(n, glm::vec3(hx, heightY, 0.0f));
+        return dot(p, n) - c;
+    }
+
+    template<typename S>
+    static S wedgeSDF(const SoAVec3<S>& p, const float hx, const float hz, const float heightY)
+    {
+        using std::max;
+        return max(boxExtrudedSDF(p, hx, hz, heightY), slopePlaneSDF(p, hx, heightY));
+    }
+
+    template<typename S>
+    static S cylinderSDF(const SoAVec3<S>& p, const glm::vec3& a, const glm::vec3& b, const float r)
+    {
+        using std::min; using std::max;
+        const SoAVec3<S> pa = p - a;
+        const glm::vec3 ba = b - a;
+        const S h = min(max(dot(pa, ba) / glm::dot(ba, ba), S(0.0f)), S(1.0f));
+        return length(pa - SoAVec3<S>(ba) * h) - r;
+    }
+
+    template<typename S>
+    static S ellipticalCylinderSDF(const SoAVec3<S>& p, const float rx, const float ry)
+    {
+        using std::sqrt;
+        return sqrt((p.x * p.x) / (rx * rx) + (p.y * p.y) / (ry * ry)) - 1.0f;
+    }
+
+    template<typename S>
+    static S cappedEllipticalCylinderSDF(const SoAVec3<S>& p, const float rx, const float ry, const float depth)
+    {
+        using std::max; using std::abs;
+        const S d1 = ellipticalCylinderSDF(p, rx, ry);
+        const S d2 = abs(p.z) - depth * 0.5f;
+        return max(d1, d2);
+    }
+
+    template<typename S>
+    static S truncatedPrismSDF(const SoAVec3<S>& p, const glm::vec2& base, const glm::vec2& top, const float height)
+    {
+        using std::min; using std::max; using std::abs; using std::sqrt;
+        // 1) clampa e t ∈ [0,1]
+        const S t = min(max(p.y, S(0.0f)), S(height)) / height;
+
+        // 2) interpola semi-extensões em XZ (mesma forma do glm::mix)
+        const S halfX = base.x * (1.0f - t) + top.x * t;
+        const S halfZ = base.y * (1.0f - t) + top.y * t;
+
+        // 3) SDF 2D no plano XZ (caixa retangular)
+        const S dx = abs(p.x) - halfX;
+        const S dz = abs(p.z) - halfZ;
+        const S ox = max(dx, S(0.0f));
+        const S oz = max(dz, S(0.0f));
+        const S dist2D = sqrt(ox * ox + oz * oz) + min(max(dx, dz), S(0.0f));
+
+        // 4) SDF em Y (caps planas em y=0 e y=height) e interseção 2D∩Y
+        const S dy = abs(p.y - height * 0.5f) - (height * 0.5f);
+        return max(dist2D, dy);
+    }
+
+    /**
+     * @brief SDF pronto para o Polygonizer: operator() escalar para amostras avulsas, evaluate() em lote
+     * (FloatLanes::Width pontos por vez) para as linhas da grade e gradient() analítico para as normais.
+     * `fn` precisa aceitar glm::vec3, SIMD::Vec3Lanes e MathUtils::DualVec3 — tipicamente uma lambda
+     * genérica que chama o SDF template do glifo.
+     */
+    template<typename Fn>
+    struct LaneSDF
+    {
+        Fn fn;
+
+        float operator()(const glm::vec3& p) const { return fn(p); }
+
+        void evaluate(const float* xs, const float* ys, const float* zs, float* out, const size_t n) const
+        {
+            SIMD::evaluateBatch(xs, ys, zs, out, n, fn);
+        }
+
+        glm::vec3 gradient(const glm::vec3& p) const { return fn(MathUtils::makeDualPoint(p)).d; }
+    };
+
+    template<typename Fn>
+    static LaneSDF<Fn> makeLaneSDF(Fn fn) { return LaneSDF<Fn>{ std::move(fn) }; }
+    
     static void RecalculateUVs(const glm::vec3 minCorner, const glm::vec3 maxCorner, std::vector<float>& vertices)
     {
         for(size_t i = 0; i < vertices.size(); i += 8)
@@ -1,16 +1,17 @@
 #pragma once
-#include "Object/Meshes/CSGImplementable.h"
-#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/GlyphMesh.h"
 
-class LetterAMesh : public Mesh, protected CSGImplementable
+class LetterAMesh : public GlyphMesh
 {
 public:
-    LetterAMesh() = default;
+    LetterAMesh();
     ~LetterAMesh() override = default;
 
 protected:
-    void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
-    
+    MeshRefiner::BuildFunction levelBuilder() const override;
+
 private:
-    float LetterAWithSDF(const glm::vec3& p);
-};
\ No newline at end of file
+    /** SDF do glifo, escrito uma vez para glm::vec3 (escalar) e SIMD::Vec3Lanes (lote). */
+    template<typename TVec3>
+    static auto LetterAWithSDF(const TVec3& p);
+};
@@ -1,16 +1,17 @@
 #pragma once
-#include "Object/Meshes/CSGImplementable.h"
-#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/GlyphMesh.h"
 
-class LetterHMesh : public Mesh, protected CSGImplementable
+class LetterHMesh : public GlyphMesh
 {
 public:
-    LetterHMesh() = default;
+    LetterHMesh();
     ~LetterHMesh() override = default;
 
 protected:
-    void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
+    MeshRefiner::BuildFunction levelBuilder() const override;
 
 private:
-    float LetterHWithSDF(const glm::vec3& p);
+    /** SDF do glifo, escrito uma vez para glm::vec3 (escalar) e SIMD::Vec3Lanes (lote). */
+    template<typename TVec3>
+    static auto LetterHWithSDF(const TVec3& p);
 };
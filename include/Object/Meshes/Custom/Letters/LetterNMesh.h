@@ -1,16 +1,17 @@
 #pragma once
-#include "Object/Meshes/CSGImplementable.h"
-#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/GlyphMesh.h"
 
-class LetterNMesh : public Mesh, protected CSGImplementable
+class LetterNMesh : public GlyphMesh
 {
 public:
-    LetterNMesh() = default;
+    LetterNMesh();
     ~LetterNMesh() override = default;
 
 protected:
-    void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
+    MeshRefiner::BuildFunction levelBuilder() const override;
 
 private:
-    float LetterNWithSDF(const glm::vec3& p);
+    /** SDF do glifo, escrito uma vez para glm::vec3 (escalar) e SIMD::Vec3Lanes (lote). */
+    template<typename TVec3>
+    static auto LetterNWithSDF(const TVec3& p);
 };
@@ -1,16 +1,17 @@
 #pragma once
-#include "Object/Meshes/CSGImplementable.h"
-#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/GlyphMesh.h"
 
-class Number2Mesh : public Mesh, protected CSGImplementable
+class Number2Mesh : public GlyphMesh
 {
 public:
-    Number2Mesh() = default;
+    Number2Mesh();
     ~Number2Mesh() override = default;
 
 protected:
-    void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
-    
+    MeshRefiner::BuildFunction levelBuilder() const override;
+
 private:
-    float Number2WithSDF(const glm::vec3& p);
-};
\ No newline at end of file
+    /** SDF do glifo, escrito uma vez para glm::vec3 (escalar) e SIMD::Vec3Lanes (lote). */
+    template<typename TVec3>
+    static auto Number2WithSDF(const TVec3& p);
+};
@@ -14,6 +14,7 @@ public:
     
 protected:
     void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
+    bool describeCacheKey(MeshCache::Key& key) const override;
 
 private:
     unsigned int m_SectorCount = 0;
@@ -20,6 +20,7 @@ public:
     
 protected:
     void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) override;
-    
+    /** O cubo não tem parâmetros: a classe já é a chave inteira. */
+    bool describeCacheKey(MeshCache::Key& /*key*/) const override { return true; }
 };
 #endif
\ No newline at end of file
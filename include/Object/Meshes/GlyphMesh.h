@@ -0,0 +1,49 @@
+#pragma once
+
+#include <utility>
+
+#include "Object/Meshes/CSGImplementable.h"
+#include "Object/Meshes/GlyphMesher.h"
+#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/MeshQuality.h"
+
+/** Base das malhas de glifos (letras e números). A subclasse só declara o volume (GlyphMesher::Shape), a versão da
+ * malha e o SDF; a chave do cache, a geração com o GlyphMesher, a simplificação e as UVs são as mesmas para todos. */
+class GlyphMesh : public Mesh, protected CSGImplementable
+{
+public:
+    ~GlyphMesh() override = default;
+
+protected:
+    /** @param shape Volume, resolução e o que o mesher pode aproveitar do SDF; também entra na chave do cache
+     * @param meshVersion Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga */
+    GlyphMesh(const GlyphMesher::Shape& shape, int meshVersion) : m_Shape(shape), m_MeshVersion(meshVersion) {}
+
+    void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) final;
+    bool describeCacheKey(MeshCache::Key& key) const final;
+    /** A subclasse devolve MakeBuilder com o SDF dela. */
+    MeshRefiner::BuildFunction levelBuilder() const override = 0;
+
+    /** @brief Gera o glifo num nível de detalhe a partir do SDF genérico (glm::vec3 e SIMD::Vec3Lanes).
+     * Leva uma cópia do volume, não `this`, então o MeshRefiner roda sem depender da malha. */
+    template<typename Fn>
+    MeshRefiner::BuildFunction MakeBuilder(Fn fn) const
+    {
+        return [shape = m_Shape, sdf = makeLaneSDF(std::move(fn))](const MeshLevel& level,
+            std::vector<float>& vertices, std::vector<unsigned int>& indices)
+        {
+            // O método (extrusão, marching cubes ou dual contouring) vem de --glyph-mesher
+            GlyphMesher::Build(sdf, shape, level, vertices, indices);
+
+            // Tira os triângulos que não mudam a forma, conforme a qualidade escolhida (--mesh-quality)
+            MeshQuality::Apply(level, vertices, indices);
+
+            RecalculateUVs(shape.minCorner, shape.maxCorner, vertices);
+            return true;
+        };
+    }
+
+private:
+    GlyphMesher::Shape m_Shape;
+    int m_MeshVersion;
+};
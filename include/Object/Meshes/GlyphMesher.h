@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "DualContouring/DualContouring.h"
+#include "Extrusion/Extrusion.h"
+#include "MarchingCubes/Polygonizer.h"
+#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/MeshCache.h"
+
+/** Como as malhas dos glifos (letras e números) são geradas a partir do SDF deles. Os três métodos recebem o mesmo
+ * SDF e o mesmo volume; a extrusão é a mais leve, os outros dois amostram o volume inteiro. */
+namespace GlyphMesher
+{
+    enum class Method
+    {
+        /** Perfil 2D extrudado em Z (Extrusion::ExtrudeProfile): tampas planas, paredes retas e quinas vivas. */
+        Extrusion,
+        /** Marching Cubes no volume (Polygonizer::PolygonizeSurface), com faixa estreita e caixa automática. */
+        MarchingCubes,
+        /** Dual Contouring em octree no volume (DualContouring::ContourSurface): quinas vivas, regiões planas colapsadas. */
+        DualContouring
+    };
+
+    struct Settings
+    {
+        Method method = Method::Extrusion;
+    };
+
+    /** Configuração global, ajustada pela linha de comando antes de criar as malhas. */
+    Settings& GetSettings();
+
+    /** @brief Lê o nome de um método ("extrusion", "marching-cubes", "dual-contouring").
+     * @return false se o nome não for conhecido (out não muda) */
+    bool Parse(const char* name, Method& out);
+
+    /** @brief Acrescenta o método à chave do cache: cada método gera outra malha. */
+    void AddToKey(MeshCache::Key& key);
+
+    /** Volume de amostragem de um glifo e o que os métodos podem aproveitar do SDF dele. */
+    struct Shape
+    {
+        glm::vec3 minCorner{ -1.0f };
+        glm::vec3 maxCorner{ 1.0f };
+        /** Células no eixo mais longo (Polygonizer::IsotropicCells); a prévia do MeshRefiner pede menos. */
+        int resolution = 128;
+        /** Meia espessura em Z do perfil extrudado (só Method::Extrusion). */
+        float halfDepth = 0.2f;
+        /** Planos de simetria x = 0, y = 0 e z = 0 do glifo. A extrusão já é simétrica em Z e só usa x e y;
+         * o marching cubes usa os três (o volume tem de estar centrado em z = 0). */
+        glm::bvec3 symmetry{ false };
+        /** Limite de |∇sdf| para a faixa estreita e a caixa automática dos métodos em volume. */
+        float lipschitz = 1.0f;
+    };
+
+    /** @brief Gera a malha do glifo com o método global, no nível de detalhe pedido (prévia ou final).
+     * O SDF segue o contrato do Polygonizer::PolygonizeSurface; todos os métodos usam as threads disponíveis
+     * e respeitam o avanço e o cancelamento do MeshLevel. Saída: pos(3), normal(3), UV(2) e índices. */
+    template<typename SDF>
+    void Build(const SDF& sdf, const Shape& shape, const MeshLevel& level,
+        std::vector<float>& vertices, std::vector<unsigned int>& indices)
+    {
+        // Mesma grade nos três métodos: células (quase) cúbicas, `resolution` no eixo mais longo
+        const glm::ivec3 cells = Polygonizer::IsotropicCells(shape.minCorner, shape.maxCorner, level.resolutionOr(shape.resolution));
+
+        switch (GetSettings().method)
+        {
+            case Method::Extrusion:
+            {
+                // Marching squares só no plano do meio, em vez de amostrar o volume inteiro
+                Extrusion::Settings settings;
+                settings.threadCount = 0;
+                settings.symmetry = glm::bvec2(shape.symmetry);
+                settings.progress = level.progress;
+                settings.cancel = level.cancel;
+                Extrusion::ExtrudeProfile(sdf, glm::vec2(shape.minCorner), glm::vec2(shape.maxCorner), glm::ivec2(cells),
+                    -shape.halfDepth, shape.halfDepth, vertices, indices, settings);
+                break;
+            }
+            case Method::MarchingCubes:
+            {
+                Polygonizer::Settings settings;
+                settings.threadCount = 0;
+                // Normais exatas quando o SDF tem gradient() (números duais no LaneSDF)
+                settings.normalMode = Polygonizer::NormalMode::Analytic;
+                // Só os blocos perto da superfície, dentro da caixa ajustada a ela; a malha é a da grade densa
+                settings.adaptive = true;
+                settings.autoBounds = true;
+                settings.lipschitz = shape.lipschitz;
+                settings.symmetry = shape.symmetry;
+                settings.progress = level.progress;
+                settings.cancel = level.cancel;
+                Polygonizer::PolygonizeSurface(sdf, shape.minCorner, shape.maxCorner, cells, vertices, indices, settings);
+                break;
+            }
+            case Method::DualContouring:
+            {
+                DualContouring::Settings settings;
+                settings.threadCount = 0;
+                settings.adaptive = true;
+                settings.lipschitz = shape.lipschitz;
+                settings.progress = level.progress;
+                settings.cancel = level.cancel;
+                DualContouring::ContourSurface(sdf, shape.minCorner, shape.maxCorner, cells, vertices, indices, settings);
+                break;
+            }
+        }
+    }
+}
@@ -7,10 +7,33 @@
     #define WIN32_LEAN_AND_MEAN
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 #include "shader.h"
 #include "Object/Core/Material.h"
+#include "Object/Meshes/MeshRefiner.h"
+#include "Object/Meshes/VertexFormat.h"
+
+struct MeshBuffers;
+
+/** Nível de detalhe pedido ao Mesh::levelBuilder: uma prévia grossa na inicialização ou a malha final,
+ * gerada em segundo plano pelo MeshRefiner com avanço e cancelamento. */
+struct MeshLevel
+{
+    /** Resolução da grade; 0 = a resolução própria da malha. */
+    int resolution = 0;
+    std::atomic<float>* progress = nullptr;
+    const std::atomic<bool>* cancel = nullptr;
+
+    /** @return A resolução pedida, sem passar da resolução final da malha */
+    [[nodiscard]] int resolutionOr(const int fullResolution) const
+    {
+        return resolution > 0 ? std::min(resolution, fullResolution) : fullResolution;
+    }
+};
 
 class Mesh {
 public:
@@ -24,33 +47,63 @@ public:
      * @return true se a inicialização foi bem-sucedida, false caso contrário */
     bool initialize();
 
-    /** @brief Renderiza a Malha
-     * @param viewMatrix Matriz de visualização
-     * @param projectionMatrix Matriz de projeção */
-    void render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::mat4& modelMatrix, const std::vector<class Light>& lights, const glm::vec3& cameraPosition);
-    
-    void setMaterial(const Material& newMaterial) { m_Material = newMaterial; }
-    [[nodiscard]] Material getMaterial() const { return m_Material; }
+    /** @brief Renderiza a Malha. Câmera e luzes vêm dos uniform buffers do frame (FrameUniforms).
+     * @param modelMatrix Matriz de modelo do objeto */
+    void render(const glm::mat4& modelMatrix);
+
+    void setMaterial(const Material& newMaterial) { m_Material = newMaterial; cacheUniformLocations(); }
+    [[nodiscard]] const Material& getMaterial() const { return m_Material; }
+
+    /** @brief VAO da geometria, dividido pelas malhas com a mesma chave; a RenderQueue agrupa os desenhos por ele.
+     * @return 0 se a malha não tem nada para desenhar (ex.: a malha invisível da câmera) */
+    [[nodiscard]] unsigned int getVertexArray() const;
+
+    /** @brief Formato dos vértices na GPU; chamar antes do initialize. O padrão é VertexFormat::Settings::defaultLayout. */
+    void setVertexLayout(const VertexFormat::Layout layout) { m_VertexLayout = layout; }
+    [[nodiscard]] VertexFormat::Layout getVertexLayout() const { return m_VertexLayout; }
 
 protected:
     /** Cada subclasse da Malha deve preencher seus próprios vértices e índices usando essa função. */
     virtual void setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices) = 0;
 
+    /** @brief Descreve tudo o que define a malha gerada (parâmetros do SDF, limites, resolução, versão). A classe
+     * já entra na chave. Malhas com a mesma chave dividem os buffers de GPU (MeshRegistry) e o arquivo do cache em
+     * disco (MeshCache). Retorne false (padrão) para malhas que não podem ser compartilhadas.
+     * Mudou o SDF ou as opções do setupMesh? Suba a versão que a malha põe na chave. */
+    virtual bool describeCacheKey(MeshCache::Key& /*key*/) const { return false; }
+
+    /** @brief Função que gera a malha num nível de detalhe (resolução da grade do SDF). Malhas que têm uma aparecem
+     * primeiro como uma prévia grossa e são refinadas em segundo plano (MeshRefiner). A função roda fora da thread
+     * do OpenGL e pode terminar depois que a malha foi destruída, então não pode guardar `this`: leva uma cópia de
+     * tudo o que usa (SDF, limites, resolução). Em caso de cancelamento a saída pode vir vazia.
+     * @return nullptr (padrão) se a malha não tem níveis; ela é gerada só pelo setupMesh */
+    virtual MeshRefiner::BuildFunction levelBuilder() const { return nullptr; }
+
     /** @brief Configura os buffers de vértices e índices. (Gera VAO, VBO e EBO) */
     void setupBuffers(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+    /** @brief Mesmo que acima, a partir de ponteiros (ex.: arquivo do cache mapeado em memória).
+     * @param vertexFloatCount Número de floats, 8 por vértice */
+    void setupBuffers(const float* vertices, size_t vertexFloatCount, const unsigned int* indices, size_t indexCount);
 
 private:
     void cacheUniformLocations();
 
+    /** @brief Sobe a prévia grossa (levelBuilder) e agenda a malha final no MeshRefiner.
+     * @return false se o refinamento progressivo está desligado ou a malha não tem níveis */
+    bool setupPreview(const MeshCache::Key* key);
+
     Material m_Material;
+    VertexFormat::Layout m_VertexLayout;
     
-    // Vertex Array Object, Vertex Buffer Object, Element Buffer Object
-    unsigned int m_vao = 0, m_vbo = 0, m_ebo = 0, m_indexCount = 0;
+    // Vertex Array Object, Vertex Buffer Object, Element Buffer Object; compartilhados pelas malhas de mesma chave
+    // (junto com a geração em segundo plano que substitui a prévia deles)
+    std::shared_ptr<MeshBuffers> m_Buffers;
     
-    // Cached uniform locations
-    GLint locModel, locView, locProjection, locViewPosition;
-    GLint locMaterialShininess, locMaterialDiffuse;
-    std::vector<GLint> locLightPosition, locLightColor, locLightConst, locLightLinear, locLightQuad;
+    // Uniforms de cada desenho no programa do material, resolvidos sempre que o material muda; os uniforms do
+    // próprio material ficam com o Material::bind
+    Shader::Uniform<glm::mat4> uModel;
+    Shader::Uniform<glm::vec3> uPositionOffset, uPositionScale;
+    Shader::Uniform<bool> uOctNormal;
 
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/vec3.hpp>
+
+/** Cache em disco das malhas geradas (marching cubes, dual contouring), para não poligonizar de novo a cada execução.
+ *
+ * Cada entrada é um arquivo <hash>.mesh no diretório do cache:
+ *   FileHeader | Bounds | blob de vértices (alinhado) | blob de índices (alinhado)
+ * Num acerto o arquivo é mapeado em memória e os blobs vão direto para o glBufferData, sem parse nem cópia. */
+namespace MeshCache
+{
+    /** Sobe quando o layout do arquivo muda; arquivos de outra versão são descartados. */
+    constexpr uint32_t FORMAT_VERSION = 1;
+
+    /** Sobe quando o Polygonizer ou o DualContouring passam a gerar malhas diferentes para o mesmo SDF (ou
+     * quando muda o que é feito com a malha antes de gravá-la, como a MeshOptimization); entra em todas as chaves,
+     * então as entradas antigas deixam de ser encontradas e saem pelo LRU. */
+    constexpr uint32_t MESHER_VERSION = 2;
+
+    /** Todos os blobs começam em múltiplos disso dentro do arquivo. */
+    constexpr size_t BLOB_ALIGNMENT = 64;
+
+    struct Settings
+    {
+        bool enabled = true;
+        std::string directory = "./mesh_cache";
+        /** Tamanho máximo do diretório; ao gravar, as entradas usadas há mais tempo são apagadas até caber. */
+        uint64_t maxBytes = 256ull << 20;
+    };
+
+    /** Configuração global, ajustada pela linha de comando antes de criar as malhas. */
+    Settings& GetSettings();
+
+    /** @brief Chave de uma malha: hash (FNV-1a 64) da classe, dos parâmetros, da resolução e das versões.
+     * Tudo que muda a malha gerada tem que entrar na chave. */
+    class Key
+    {
+    public:
+        explicit Key(const char* meshClass);
+
+        Key& add(const void* data, size_t size);
+        Key& add(const char* text);
+        Key& add(int value) { return add(&value, sizeof(value)); }
+        Key& add(uint32_t value) { return add(&value, sizeof(value)); }
+        Key& add(float value) { return add(&value, sizeof(value)); }
+        Key& add(const glm::vec3& value) { return add(&value, sizeof(value)); }
+
+        [[nodiscard]] uint64_t hash() const { return m_Hash; }
+
+    private:
+        uint64_t m_Hash;
+    };
+
+    /** @brief Entrada do cache mapeada em memória (somente leitura). Os ponteiros valem enquanto o objeto existir. */
+    class MappedMesh
+    {
+    public:
+        MappedMesh() = default;
+        ~MappedMesh();
+        MappedMesh(const MappedMesh&) = delete;
+        MappedMesh& operator=(const MappedMesh&) = delete;
+
+        [[nodiscard]] const float* vertices() const { return m_Vertices; }
+        /** Número de floats (8 por vértice: posição, normal, UV). */
+        [[nodiscard]] size_t vertexFloatCount() const { return m_VertexFloatCount; }
+        [[nodiscard]] const unsigned int* indices() const { return m_Indices; }
+        [[nodiscard]] size_t indexCount() const { return m_IndexCount; }
+        [[nodiscard]] glm::vec3 boundsMin() const { return m_BoundsMin; }
+        [[nodiscard]] glm::vec3 boundsMax() const { return m_BoundsMax; }
+
+    private:
+        friend bool Load(const Key& key, MappedMesh& out);
+        void unmap();
+
+        void* m_Base = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+
+        const float* m_Vertices = nullptr;
+        size_t m_VertexFloatCount = 0;
+        const unsigned int* m_Indices = nullptr;
+        size_t m_IndexCount = 0;
+        glm::vec3 m_BoundsMin{ 0.0f }, m_BoundsMax{ 0.0f };
+    };
+
+    /** @brief Procura a chave no cache e mapeia o arquivo. Entradas corrompidas ou de outra versão são apagadas.
+     * @return true num acerto; false se o cache estiver desligado ou a entrada não existir */
+    bool Load(const Key& key, MappedMesh& out);
+
+    /** @brief Grava a malha (arquivo temporário + rename, para nunca deixar entrada pela metade) e aplica o limite
+     * de tamanho. Falhas só desligam o cache desta malha; a malha em memória continua valendo.
+     * @return true se a entrada foi gravada */
+    bool Store(const Key& key, const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+    /** Apaga a entrada da chave, se existir. */
+    void Invalidate(const Key& key);
+
+    /** Apaga todas as entradas do diretório do cache. */
+    void Clear();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "Object/Meshes/MeshCache.h"
+
+struct MeshLevel;
+
+/** Qualidade das malhas geradas por SDF: quanto a simplificação (Simplification::SimplifyMesh) pode tirar da malha
+ * final antes de ela ir para a GPU. */
+namespace MeshQuality
+{
+    enum class Level
+    {
+        /** Malha como sai do Polygonizer ou da Extrusion. */
+        Full,
+        /** Tira os triângulos de área zero e os que não mudam a forma (erro de até 1e-4). */
+        Balanced,
+        /** Erro de até 1e-3: paredes curvas bem mais leves, diferença visível só de perto. */
+        Draft
+    };
+
+    struct Settings
+    {
+        Level level = Level::Balanced;
+    };
+
+    /** Configuração global, ajustada pela linha de comando antes de criar as malhas. */
+    Settings& GetSettings();
+
+    /** @brief Lê o nome de um nível ("full", "balanced", "draft").
+     * @return false se o nome não for conhecido (out não muda) */
+    bool Parse(const char* name, Level& out);
+
+    /** @brief Acrescenta o nível à chave do cache: a malha simplificada é outra malha. */
+    void AddToKey(MeshCache::Key& key);
+
+    /** @brief Simplifica a malha de acordo com o nível global. Prévias (MeshLevel::resolution > 0) já são grossas e
+     * ficam como estão; o cancelamento do MeshLevel vale também para a simplificação. */
+    void Apply(const MeshLevel& level, std::vector<float>& vertices, std::vector<unsigned int>& indices);
+}
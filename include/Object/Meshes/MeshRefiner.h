@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Object/Meshes/MeshCache.h"
+
+struct MeshBuffers;
+struct MeshLevel;
+
+/** Refinamento progressivo das malhas geradas por SDF.
+ *
+ * Na inicialização cada malha sobe uma prévia grossa (Settings::previewResolution), então a janela abre na hora.
+ * A malha final é poligonizada numa thread de fundo (que usa o pool de threads do Polygonizer) e, quando fica
+ * pronta, ProcessCompleted troca o conteúdo dos buffers de GPU na thread do OpenGL: todas as Meshes que dividem
+ * a geometria passam a desenhar a malha final no mesmo frame. A malha final também vai para o MeshCache, então
+ * na próxima execução ela é carregada direto, sem prévia. */
+namespace MeshRefiner
+{
+    struct Settings
+    {
+        bool enabled = true;
+        int previewResolution = 32;
+    };
+
+    /** Configuração global, ajustada pela linha de comando antes de criar as malhas. */
+    Settings& GetSettings();
+
+    enum class JobState
+    {
+        Queued,
+        Running,
+        /** Malha final gerada, esperando o ProcessCompleted. */
+        Ready,
+        /** Buffers trocados pela malha final. */
+        Done,
+        Cancelled
+    };
+
+    using BuildFunction = std::function<bool(const MeshLevel&, std::vector<float>&, std::vector<unsigned int>&)>;
+
+    /** @brief Refinamento de uma geometria. Avanço e estado podem ser lidos de qualquer thread. */
+    class Job
+    {
+    public:
+        Job(BuildFunction build, std::weak_ptr<MeshBuffers> target, const MeshCache::Key* cacheKey);
+
+        /** Avanço da malha final em [0, 1]. */
+        [[nodiscard]] float progress() const { return m_Progress.load(std::memory_order_relaxed); }
+        [[nodiscard]] JobState state() const { return m_State.load(); }
+
+        /** Pede o cancelamento; o Polygonizer para no próximo plano. A prévia continua sendo desenhada. */
+        void cancel() { m_Cancel.store(true); }
+
+    private:
+        friend class Worker;
+
+        BuildFunction m_Build;
+        std::weak_ptr<MeshBuffers> m_Target;
+        MeshCache::Key m_CacheKey;
+        bool m_Keyed;
+
+        std::atomic<float> m_Progress{ 0.0f };
+        std::atomic<bool> m_Cancel{ false };
+        std::atomic<JobState> m_State{ JobState::Queued };
+
+        std::vector<float> m_Vertices;
+        std::vector<unsigned int> m_Indices;
+    };
+
+    /** @brief Agenda a geração da malha final. A função roda na thread de fundo com MeshLevel::resolution = 0.
+     * @param target Buffers que recebem a malha final (e guardam o job); se todas as Meshes que os usam forem destruídas, o job é descartado
+     * @param cacheKey Chave em que a malha final é gravada no MeshCache, ou nullptr */
+    std::shared_ptr<Job> Submit(BuildFunction build, std::weak_ptr<MeshBuffers> target, const MeshCache::Key* cacheKey);
+
+    /** @brief Sobe para a GPU as malhas finais que ficaram prontas. Chamar a cada frame, na thread do OpenGL.
+     * @return Número de geometrias trocadas */
+    size_t ProcessCompleted();
+
+    struct Status
+    {
+        /** Jobs ainda não trocados (na fila, rodando ou prontos). */
+        size_t pending = 0;
+        /** Avanço médio dos jobs pendentes, em [0, 1]. */
+        float progress = 1.0f;
+    };
+
+    Status GetStatus();
+
+    /** Cancela todos os jobs e para a thread de fundo. Chamar antes de destruir o contexto OpenGL. */
+    void Shutdown();
+
+    /** @brief Chama Shutdown ao sair do escopo, por qualquer caminho (inclusive os retornos de erro). Declare depois
+     * da janela e antes das malhas: ele roda depois que a cena some e antes do contexto OpenGL. */
+    class ScopedShutdown
+    {
+    public:
+        ScopedShutdown() = default;
+        ~ScopedShutdown() { Shutdown(); }
+        ScopedShutdown(const ScopedShutdown&) = delete;
+        ScopedShutdown& operator=(const ScopedShutdown&) = delete;
+    };
+}
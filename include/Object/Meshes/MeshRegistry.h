@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Object/Meshes/VertexFormat.h"
+
+namespace MeshRefiner { class Job; }
+
+/** Buffers de GPU de uma malha (VAO, VBO e EBO). Apagados quando a última Mesh que os usa é destruída. */
+struct MeshBuffers
+{
+    unsigned int vao = 0, vbo = 0, ebo = 0, indexCount = 0;
+
+    /** Formato dos vértices; escolhido antes do primeiro upload e mantido nos seguintes. */
+    VertexFormat::Layout layout = VertexFormat::Layout::Float32;
+    /** Escala e deslocamento das posições do Layout::Packed (identidade em Float32), para o vertex shader. */
+    VertexFormat::Dequantization dequantization;
+    /** Índices em 16 bits (GL_UNSIGNED_SHORT) quando todos os vértices cabem. */
+    bool shortIndices = false;
+    /** Nome usado no relatório do VertexFormat::Settings::report. */
+    std::string label;
+
+    /** Bytes na GPU (VBO + EBO) e quanto ocupariam em floats e índices de 32 bits. */
+    size_t gpuBytes = 0;
+    size_t float32Bytes = 0;
+
+    /** Malha final sendo gerada em segundo plano para trocar a prévia (MeshRefiner). Pertence aos buffers, não à Mesh
+     * que os criou: segue enquanto alguma Mesh desenha a geometria e é cancelada quando a última a larga. */
+    std::shared_ptr<MeshRefiner::Job> refinement;
+
+    MeshBuffers() = default;
+    ~MeshBuffers();
+    MeshBuffers(const MeshBuffers&) = delete;
+    MeshBuffers& operator=(const MeshBuffers&) = delete;
+
+    /** @brief Envia vértices (pos, normal, UV: 8 floats cada) e índices, convertidos para o layout. Na primeira
+     * chamada cria VAO, VBO e EBO; nas seguintes troca o conteúdo dos mesmos objetos, então toda Mesh que divide os
+     * buffers passa a desenhar a geometria nova no próximo frame (é assim que o MeshRefiner troca a prévia pela
+     * malha final). */
+    void upload(const float* vertices, size_t vertexFloatCount, const unsigned int* indices, size_t indexCount);
+};
+
+/** Registro das geometrias já enviadas à GPU, pela mesma chave do MeshCache (classe + parâmetros).
+ * Várias instâncias do mesmo glifo (ex.: os dois 'A' de "EACH 20 ANOS") poligonizam e sobem os buffers uma vez
+ * só; cada Mesh continua com o próprio material. O registro guarda referências fracas: não mantém nada vivo.
+ * Só é usado na thread do contexto OpenGL, como os próprios buffers. */
+namespace MeshRegistry
+{
+    /** @return Os buffers registrados com a chave, ou nullptr se nenhuma malha viva os usa */
+    std::shared_ptr<MeshBuffers> Find(uint64_t key);
+
+    void Add(uint64_t key, const std::shared_ptr<MeshBuffers>& buffers);
+
+    /** Número de geometrias distintas vivas no momento. */
+    size_t LiveCount();
+
+    /** @brief Liga o VAO (glBindVertexArray), a menos que ele já seja o ligado. Todo bind de VAO passa por aqui,
+     * então o VAO de um desenho pode ficar ligado para o próximo desenho da mesma geometria.
+     * @return false se o bind foi evitado */
+    bool BindVertexArray(unsigned int vao);
+}
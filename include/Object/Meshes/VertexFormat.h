@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+
+/** Formatos de vértice na GPU. As malhas são geradas (e guardadas no MeshCache) sempre em floats: pos(3), normal(3),
+ * UV(2). A conversão para o formato da malha é feita ao subir os buffers (MeshBuffers::upload). */
+namespace VertexFormat
+{
+    enum class Layout
+    {
+        /** 8 floats, 32 B por vértice: o formato de geração, sem conversão. */
+        Float32,
+        /** 16 B por vértice: posição em int16 relativa à caixa da malha, normal em octaedro (2 x int16) e UV em
+         * half float. O erro de posição é de no máximo (tamanho da caixa) / 65534 por eixo. */
+        Packed
+    };
+
+    struct Settings
+    {
+        /** Formato das malhas que não escolhem um (Mesh::setVertexLayout). */
+        Layout defaultLayout = Layout::Packed;
+        /** Escreve no console o tamanho de cada malha enviada à GPU e quanto o formato economizou, e a eficiência
+         * do cache de vértices (ACMR/ATVR) antes e depois da MeshOptimization. */
+        bool report = false;
+    };
+
+    /** Configuração global, ajustada pela linha de comando antes de criar as malhas. */
+    Settings& GetSettings();
+
+    /** @brief Lê o nome de um formato ("float", "packed").
+     * @return false se o nome não for conhecido (out não muda) */
+    bool Parse(const char* name, Layout& out);
+
+    /** Vértice do Layout::Packed. As posições e normais são inteiros sem normalização do GL (o shader multiplica
+     * pela escala), então a conversão não depende da versão do OpenGL. */
+    struct PackedVertex
+    {
+        int16_t position[3];
+        int16_t padding;
+        /** Normal no octaedro, em [-32767, 32767]. */
+        int16_t normal[2];
+        /** UV em half float. */
+        uint16_t uv[2];
+    };
+    static_assert(sizeof(PackedVertex) == 16, "PackedVertex tem que ter 16 bytes");
+
+    /** Como o vertex shader volta às coordenadas do modelo: posição = offset + scale * inteiro. */
+    struct Dequantization
+    {
+        glm::vec3 offset{ 0.0f };
+        glm::vec3 scale{ 1.0f };
+    };
+
+    /** @brief Converte vértices de 8 floats para o Layout::Packed.
+     * @return A escala e o deslocamento das posições (a caixa dos vértices) */
+    Dequantization PackVertices(const float* vertices, size_t vertexCount, std::vector<PackedVertex>& out);
+
+    /** @brief Copia os índices para 16 bits.
+     * @return false (out vazio) se algum índice não couber */
+    bool NarrowIndices(const unsigned int* indices, size_t indexCount, size_t vertexCount, std::vector<uint16_t>& out);
+
+    /** @return Bytes por vértice do formato */
+    size_t Stride(Layout layout);
+
+    /** @brief Declara os atributos 0 (posição), 1 (normal) e 2 (UV) do formato no VAO ligado, lendo do
+     * GL_ARRAY_BUFFER ligado. */
+    void SetupAttributes(Layout layout);
+}
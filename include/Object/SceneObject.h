@@ -15,7 +15,8 @@ public:
     SceneObject(const std::string& name, Mesh* mesh, const Material& material);
     SceneObject(const std::string& name, Transform transform, Mesh* mesh, const Material& material);
 
-    void Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraPosition, const std::vector<Light>& lights) const;
+    /** Desenha com a câmera e as luzes do frame, já nos uniform buffers (FrameUniforms). */
+    void Draw() const;
 
     // Components Logic
     void AddComponent(std::unique_ptr<IComponent> component);
@@ -30,7 +31,7 @@ public:
     
     // Core Getters and Setters
     [[nodiscard]] Transform GetTransform() const { return m_Transform; }
-    [[nodiscard]] Material GetMaterial() const { return m_Mesh->getMaterial(); }
+    [[nodiscard]] const Material& GetMaterial() const { return m_Mesh->getMaterial(); }
     [[nodiscard]] Mesh* GetMesh() const { return m_Mesh.get(); }
 
     void SetTransform(const Transform& transform) { m_Transform = transform; }
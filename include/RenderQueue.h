@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Mesh;
+
+/**
+ * @class RenderQueue
+ * @brief Desenhos de um frame, ordenados por uma chave de 64 bits antes de ir para a GPU.
+ *
+ * Cada desenho vira uma chave com o passo, o programa, a textura, a geometria e a profundidade. A ordenação
+ * (radix sort) deixa juntos os desenhos que dividem estado, então o programa, a textura e o VAO só são ligados
+ * quando mudam (ShaderRegistry, TextureRegistry e MeshRegistry pulam os binds repetidos), e separa os passos:
+ *  - opacos: sem blending, agrupados por estado e, dentro do mesmo estado, da frente para trás, para o teste de
+ *    profundidade descartar o que fica atrás;
+ *  - transparentes (Material::transparent): com blending e sem escrever profundidade, de trás para frente.
+ */
+class RenderQueue
+{
+public:
+    /** Contadores do último submit. As trocas são as vezes em que o desenho usa um estado diferente do anterior. */
+    struct Stats
+    {
+        size_t draws = 0;
+        size_t opaque = 0;
+        size_t transparent = 0;
+        size_t programSwitches = 0;
+        size_t textureSwitches = 0;
+        size_t meshSwitches = 0;
+    };
+
+    /** @brief Esvazia a fila para um novo frame (a memória fica). */
+    void clear();
+
+    /**
+     * @brief Enfileira um desenho. Malhas sem geometria (getVertexArray() == 0) são ignoradas.
+     * @param mesh Malha, que precisa continuar viva até o submit
+     * @param modelMatrix Matriz de modelo do objeto
+     * @param depth Distância até a câmera ao longo da direção em que ela olha
+     */
+    void add(Mesh& mesh, const glm::mat4& modelMatrix, float depth);
+
+    /** @brief Ordena e desenha a fila: opacos e depois transparentes. Deixa o blending desligado e a escrita de
+     * profundidade ligada. */
+    void submit();
+
+    [[nodiscard]] const Stats& getStats() const { return m_stats; }
+
+    /**
+     * @brief Monta a chave de ordenação. Só os bits baixos de cada id entram; ids que colidem só deixam a ordem
+     * menos agrupada, nunca o desenho errado.
+     *  - opaco:       [63] 0 | programa 12 | textura 12 | geometria 14 | profundidade 25
+     *  - transparente:[63] 1 | ~profundidade 25 | programa 12 | textura 12 | geometria 14
+     */
+    static uint64_t MakeKey(bool transparent, unsigned int program, unsigned int texture, unsigned int mesh, float depth);
+
+    /** @brief Índices das chaves em ordem crescente (radix sort). Estável: chaves iguais ficam na ordem da fila.
+     * @param order Recebe os índices
+     * @param scratch Memória de trabalho, reaproveitada entre frames */
+    static void SortByKey(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch);
+
+private:
+    struct Item
+    {
+        Mesh* mesh;
+        glm::mat4 modelMatrix;
+        unsigned int program, texture, vertexArray;
+    };
+
+    std::vector<Item> m_items;
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_order, m_scratch;
+    Stats m_stats;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+/** SDFs descritos como dados: uma árvore de primitivas do CSGImplementable, operações booleanas e
+ * transformações do ponto, compilada para bytecode (SDFProgram::Program) em vez de escrita em C++.
+ *
+ *     using namespace SDFProgram;
+ *     const Expr ring = Subtract(Cylinder({0,0,-0.3f}, {0,0,0.3f}, 0.65f), Cylinder({0,0,-0.3f}, {0,0,0.3f}, 0.45f));
+ *     const Program program = Program::Compile(Intersection(ring, Plane({1,0,0}, 0.3f)));
+ *
+ * As primitivas têm os mesmos parâmetros e a mesma matemática das funções *SDF do CSGImplementable,
+ * então um glifo portado para uma expressão gera exatamente a mesma malha. */
+namespace SDFProgram
+{
+    enum class NodeKind
+    {
+        // Primitivas: parâmetros na ordem das funções do CSGImplementable
+        Box,                        // halfExtents(3)
+        BoxExtruded,                // hx, hz, heightY
+        Cylinder,                   // a(3), b(3), r
+        CappedCylinder,             // a(3), b(3), r
+        CappedEllipticalCylinder,   // rx, ry, depth
+        TruncatedPrism,             // base(2), top(2), height
+        Plane,                      // n(3), offset
+        RightTrianglePrism,         // baseXZ(2), heightY
+        RotatedRightTriangle,       // baseXZ(2), heightY, angleDeg
+        Wedge,                      // hx, hz, heightY
+
+        // Operações booleanas sobre os dois filhos
+        Union,
+        Intersection,
+        Subtract,
+
+        // Transformações: o filho é avaliado no ponto transformado
+        Translate,                  // offset(3): filho(p - offset)
+        RotateZ                     // angleDeg: filho(rotateZ(p, angleDeg))
+    };
+
+    struct Node
+    {
+        NodeKind kind;
+        std::vector<float> params;
+        std::shared_ptr<const Node> a, b;
+    };
+
+    /** @brief Expressão SDF imutável. Cópias são baratas e dividem os nós, então subexpressões podem ser reusadas. */
+    class Expr
+    {
+    public:
+        explicit Expr(std::shared_ptr<const Node> node) : m_Node(std::move(node)) {}
+
+        [[nodiscard]] const Node& node() const { return *m_Node; }
+        [[nodiscard]] const std::shared_ptr<const Node>& shared() const { return m_Node; }
+
+    private:
+        std::shared_ptr<const Node> m_Node;
+    };
+
+    Expr Box(const glm::vec3& halfExtents);
+    Expr BoxExtruded(float hx, float hz, float heightY);
+    Expr Cylinder(const glm::vec3& a, const glm::vec3& b, float r);
+    Expr CappedCylinder(const glm::vec3& a, const glm::vec3& b, float r);
+    Expr CappedEllipticalCylinder(float rx, float ry, float depth);
+    Expr TruncatedPrism(const glm::vec2& base, const glm::vec2& top, float height);
+    Expr Plane(const glm::vec3& n, float offset);
+    Expr RightTrianglePrism(const glm::vec2& baseXZ, float heightY);
+    Expr RotatedRightTriangle(const glm::vec2& baseXZ, float heightY, float angleDeg = 0.0f);
+    Expr Wedge(float hx, float hz, float heightY);
+
+    Expr Union(const Expr& a, const Expr& b);
+    Expr Intersection(const Expr& a, const Expr& b);
+    /** a menos b: max(a, -b), como CSGImplementable::opSubtract. */
+    Expr Subtract(const Expr& a, const Expr& b);
+
+    /** Desloca a forma por offset: avalia e em p - offset. */
+    Expr Translate(const Expr& e, const glm::vec3& offset);
+    /** Avalia e em rotateZ(p, angleDeg), como CSGImplementable::rotateZ. */
+    Expr RotateZ(const Expr& e, float angleDeg);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+
+#include "SDFProgram/Expression.h"
+#include "Utility/Math/Interval.h"
+
+namespace SDFProgram
+{
+    enum class OpCode : uint8_t
+    {
+        // Ponto: dst (registrador de ponto) <- a (registrador de ponto)
+        Translate, RotateZ,
+        // Primitiva: dst (registrador de valor) <- a (registrador de ponto)
+        Box, BoxExtruded, Cylinder, CappedCylinder, CappedEllipticalCylinder, TruncatedPrism, Plane,
+        RightTrianglePrism, RotatedRightTriangle, Wedge,
+        // Valor: dst <- a, b
+        Union, Intersection, Subtract,
+        // Valor: dst <- -a (só aparece em programas podados, quando a - b se reduz a -b)
+        Negate
+    };
+
+    /** Uma instrução do bytecode; `constants` indexa o vetor de constantes do programa. */
+    struct Instruction
+    {
+        OpCode op;
+        uint16_t dst, a, b;
+        uint32_t constants;
+    };
+
+    /**
+     * @brief Expressão compilada para bytecode linear (SSA: cada instrução escreve um registrador novo).
+     * Atende o contrato de SDF do Polygonizer e do DualContouring: operator() escalar, evaluate() em lote
+     * e gradient() analítico (números duais).
+     *
+     * No lote, os pontos são avaliados em blocos de PRUNE_BLOCK: para cada bloco o programa é avaliado uma vez
+     * em aritmética intervalar sobre a caixa dos pontos, e uniões/interseções/subtrações cujo resultado já está
+     * decidido na caixa inteira viram o operando vencedor; a subárvore perdedora não é executada. A poda é
+     * exata (o operando vencedor é o mesmo valor que o min/max escolheria), então a malha não muda.
+     */
+    class Program
+    {
+    public:
+        /** Pontos por bloco de poda no evaluate() em lote. */
+        static constexpr size_t PRUNE_BLOCK = 256;
+        /** Programas menores que isso não são podados: a passada intervalar custaria mais do que economiza. */
+        static constexpr size_t MIN_PRUNE_INSTRUCTIONS = 12;
+
+        static Program Compile(const Expr& root);
+
+        float operator()(const glm::vec3& p) const;
+
+        void evaluate(const float* xs, const float* ys, const float* zs, float* out, size_t n) const;
+
+        glm::vec3 gradient(const glm::vec3& p) const;
+
+        /** Limites da distância em toda a caixa [minCorner, maxCorner]. */
+        [[nodiscard]] MathUtils::Interval bounds(const glm::vec3& minCorner, const glm::vec3& maxCorner) const;
+
+        /** @brief Programa podado para a caixa: só as instruções que ainda decidem o valor lá dentro.
+         * @param out Recebe as instruções (usa as constantes e os registradores deste programa) */
+        void specialize(const glm::vec3& minCorner, const glm::vec3& maxCorner, std::vector<Instruction>& out) const;
+
+        /** Liga/desliga a poda por intervalos no evaluate() em lote (ligada por padrão). */
+        void setPruning(const bool enabled) { m_Pruning = enabled; }
+
+        [[nodiscard]] size_t instructionCount() const { return m_Code.size(); }
+        [[nodiscard]] const std::vector<Instruction>& code() const { return m_Code; }
+
+    private:
+        template<typename S>
+        void run(const Instruction* code, size_t count, const MathUtils::GenericVec3<S>* input, size_t lanes,
+            std::vector<MathUtils::GenericVec3<S>>& points, std::vector<S>& values) const;
+
+        std::vector<Instruction> m_Code;
+        std::vector<float> m_Constants;
+        uint16_t m_PointRegisters = 1;
+        uint16_t m_ValueRegisters = 0;
+        uint16_t m_Result = 0;
+        bool m_Pruning = true;
+
+        friend class Compiler;
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Programa de shader na GPU. Apagado quando o último Shader que o usa é destruído. */
+struct ShaderProgram
+{
+    /** Uniform ativo, lido com glGetActiveUniform ao vincular, e o último valor enviado a ele. */
+    struct Uniform
+    {
+        std::string name;
+        int location = -1;
+        /** Tipo GLSL (GL_FLOAT_VEC3, GL_SAMPLER_2D...). */
+        unsigned int type = 0;
+        /** Bytes do último valor enviado (até uma mat4); hasValue fica false até o primeiro envio. */
+        float value[16] = {};
+        bool hasValue = false;
+    };
+
+    unsigned int id = 0;
+    /** Tabela plana dos uniforms fora de blocos; cada elemento de um array tem a própria entrada. */
+    std::vector<Uniform> uniforms;
+    /** Nome -> posição em uniforms. Arrays aparecem como "nome", "nome[0]", "nome[1]"... */
+    std::unordered_map<std::string, int> slots;
+
+    /** @return A posição do uniform em uniforms, ou -1 se o programa não o tem (ou o compilador o removeu) */
+    int slot(const std::string& name) const
+    {
+        const auto it = slots.find(name);
+        return it == slots.end() ? -1 : it->second;
+    }
+
+    ShaderProgram() = default;
+    ~ShaderProgram();
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+};
+
+/** Registro dos programas já compilados, pela chave (vertex shader, fragment shader, defines).
+ * Cada SceneObject tem um Material com um Shader próprio, mas todos que pedem os mesmos arquivos e defines
+ * dividem um programa só: os arquivos são lidos, compilados e vinculados uma vez, e o driver guarda um
+ * programa em vez de um por objeto. O registro guarda referências fracas: não mantém nada vivo.
+ * Só é usado na thread do contexto OpenGL, como os próprios programas. */
+namespace ShaderRegistry
+{
+    /** @brief Devolve o programa registrado com a chave, ou lê, compila e registra um novo.
+     * @param defines Linhas "NOME" ou "NOME VALOR", inseridas como #define logo depois do #version dos dois
+     * estágios. A ordem faz parte da chave.
+     * @return O programa; em caso de erro de leitura ou compilação ele existe mesmo assim (o erro vai para o
+     * console), como antes do registro */
+    std::shared_ptr<ShaderProgram> Acquire(const std::string& vertexPath, const std::string& fragmentPath,
+        const std::vector<std::string>& defines = {});
+
+    /** Número de programas distintos vivos no momento. */
+    size_t LiveCount();
+
+    /** Número de programas compilados desde o início (um por chave, de novo só se todos os usuários morreram). */
+    size_t CompileCount();
+
+    /** @brief Torna o programa o atual (glUseProgram), a menos que ele já seja. */
+    void UseProgram(unsigned int id);
+
+    struct Settings
+    {
+        /** Mostra, junto do FPS, as chamadas glUniform e glUseProgram por frame e quantas os caches evitaram. */
+        bool report = false;
+    };
+
+    /** Configuração global, ajustada pela linha de comando. */
+    Settings& GetSettings();
+
+    /** Chamadas ao OpenGL feitas e evitadas pelos Shaders, acumuladas até alguém zerar. */
+    struct CallStats
+    {
+        /** glUniform* enviados, e os pulados porque o programa já tinha o mesmo valor. */
+        size_t uniformUploads = 0;
+        size_t redundantUploads = 0;
+        /** Usos de um uniform pelo nome (Shader::setInt...), resolvidos na tabela em vez de glGetUniformLocation. */
+        size_t nameLookups = 0;
+        /** glUseProgram enviados, e os pulados porque o programa já era o atual. */
+        size_t programBinds = 0;
+        size_t redundantBinds = 0;
+
+        /** Chamadas que os caches pouparam. */
+        size_t saved() const { return redundantUploads + nameLookups + redundantBinds; }
+    };
+
+    CallStats& GetCallStats();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Simplification
+{
+    /** Contadores de uma chamada, preenchidos quando Settings::stats aponta para eles. */
+    struct Stats
+    {
+        size_t inputTriangles = 0;
+        size_t outputTriangles = 0;
+        size_t inputVertices = 0;
+        size_t outputVertices = 0;
+        /** Triângulos com dois cantos no mesmo ponto, tirados antes de começar. */
+        size_t degenerateTriangles = 0;
+        size_t collapses = 0;
+        /** Dos colapsos, os feitos em paralelo dentro das fatias (o resto é da passada final, serial). */
+        size_t parallelCollapses = 0;
+        /** Colapsos recusados: dobra, desvio de normal, quina, borda ou topologia. */
+        size_t rejectedCollapses = 0;
+        double ms = 0.0;
+    };
+
+    /** Opções da simplificação. */
+    struct Settings
+    {
+        /** Para quando sobrarem até tantos triângulos. 0 = sem alvo, só maxError. */
+        size_t targetTriangles = 0;
+
+        /** Erro máximo de um colapso: distância RMS (média ponderada pela área) do vértice que fica aos planos das
+         * faces originais que os dois vértices já absorveram. 0 = sem limite, só o alvo; com os dois em 0, saem só
+         * os colapsos sem erro nenhum (faces coplanares, pontos alinhados). */
+        float maxError = 1e-3f;
+
+        /** Nenhuma face pode girar mais do que isso em relação à face original que ela substitui. Também é o quanto
+         * as normais de um vértice de quina (vértices no mesmo lugar com normais diferentes) podem mudar. */
+        float maxNormalDeviationDeg = 20.0f;
+
+        /** Vértices em arestas abertas (de um só triângulo) ficam parados. false: eles podem deslizar ao longo
+         * da borda, presos por planos perpendiculares a ela. */
+        bool preserveBoundary = true;
+
+        /** Número de threads. 1 = serial, 0 = todos os núcleos. Malhas grandes são divididas em fatias
+         * simplificadas em paralelo; a divisão depende só da malha, então a saída é a mesma com qualquer número
+         * de threads. */
+        unsigned int threadCount = 1;
+
+        Stats* stats = nullptr;
+
+        /** Quando vira true (em outra thread), a chamada para e retorna sem mexer na malha. */
+        const std::atomic<bool>* cancel = nullptr;
+    };
+
+    /** @brief Simplificação por colapso de arestas guiado por quádricas de erro (Garland e Heckbert 1997), no
+     * formato de saída do Polygonizer: pos(3), normal(3), UV(2) e índices. Substitui vertices/indices pela malha
+     * simplificada.
+     *
+     * Cada colapso leva um vértice até um vizinho (o que fica não se move), então os vértices restantes continuam
+     * sobre a superfície e com as normais originais. Vértices no mesmo lugar com normais ou UVs diferentes (quinas
+     * separadas) são tratados como um ponto só e a separação é mantida. Triângulos degenerados (dois cantos no
+     * mesmo ponto) saem antes; os de área zero e as lascas finas somem com os primeiros colapsos, que não custam
+     * nada. Os colapsos que mudariam a topologia, dobrariam uma face ou girariam uma face mais do que
+     * maxNormalDeviationDeg são recusados. */
+    void SimplifyMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, const Settings& settings);
+}
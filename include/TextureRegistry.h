@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <glad/glad.h>
+
+/** Filtros e repetição de uma textura, definidos ao criá-la. Fazem parte da chave do TextureRegistry: o mesmo
+ * arquivo com outro SamplerState vira outra textura na GPU. */
+struct SamplerState
+{
+    GLint wrapS = GL_REPEAT;
+    GLint wrapT = GL_REPEAT;
+    GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint magFilter = GL_LINEAR;
+
+    bool operator==(const SamplerState& other) const
+    {
+        return wrapS == other.wrapS && wrapT == other.wrapT && minFilter == other.minFilter && magFilter == other.magFilter;
+    }
+};
+
+/** Textura na GPU, decodificada de um arquivo. Apagada quando o último Texture que a usa é destruído. */
+struct TextureImage
+{
+    unsigned int id = 0;
+    int width = 0, height = 0, channels = 0;
+    /** false se o arquivo não pôde ser lido ou tem um formato não suportado; o id existe mesmo assim, vazio. */
+    bool loaded = false;
+
+    TextureImage() = default;
+    ~TextureImage();
+    TextureImage(const TextureImage&) = delete;
+    TextureImage& operator=(const TextureImage&) = delete;
+};
+
+/** Registro das texturas já enviadas à GPU, pela chave (caminho, SamplerState).
+ * Todo Material padrão usa a mesma textura; com o registro, o arquivo é decodificado, enviado e tem os mipmaps
+ * gerados uma vez só, e cada Texture é só uma referência para ela. O registro guarda referências fracas: não
+ * mantém nada vivo. Só é usado na thread do contexto OpenGL, como as próprias texturas. */
+namespace TextureRegistry
+{
+    /** @brief Devolve a textura registrada com a chave, ou decodifica o arquivo, envia e registra uma nova.
+     * @return A textura; em caso de erro ela existe mesmo assim, com loaded = false (o erro vai para o console) */
+    std::shared_ptr<TextureImage> Acquire(const std::string& filePath, const SamplerState& sampler = {});
+
+    /** Número de texturas distintas vivas no momento. */
+    size_t LiveCount();
+
+    /** Número de arquivos decodificados desde o início (um por chave, de novo só se todos os usuários morreram). */
+    size_t DecodeCount();
+
+    /** @brief Liga a textura 2D na unidade (glActiveTexture + glBindTexture), pulando o que já estiver ligado.
+     * Todo bind de textura passa por aqui, para o registro saber o que está ligado em cada unidade.
+     * @return false se o bind foi evitado */
+    bool BindTexture(unsigned int unit, unsigned int id);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @class WeakRegistry
+ * @brief Tabela de recursos compartilhados por chave, com referências fracas: não mantém nada vivo. Quem pede uma
+ * chave já registrada recebe o mesmo objeto enquanto algum usuário o segura; quando o último o larga, a próxima
+ * chamada cria outro. Base do ShaderRegistry, do TextureRegistry e do MeshRegistry. Não é thread-safe.
+ */
+template<typename Key, typename T, typename Hash = std::hash<Key>>
+class WeakRegistry
+{
+public:
+    /** @return O objeto vivo registrado com a chave, ou nullptr */
+    std::shared_ptr<T> find(const Key& key) const
+    {
+        const auto it = m_Entries.find(key);
+        return it == m_Entries.end() ? nullptr : it->second.lock();
+    }
+
+    /** @brief Registra o objeto com a chave, no lugar do que estiver lá. As entradas cujos usuários já morreram
+     * saem antes, então a tabela só cresce com o número de objetos vivos. */
+    void add(const Key& key, const std::shared_ptr<T>& value)
+    {
+        for (auto it = m_Entries.begin(); it != m_Entries.end();)
+            it = it->second.expired() ? m_Entries.erase(it) : std::next(it);
+        m_Entries[key] = value;
+    }
+
+    /** @brief Devolve o objeto vivo da chave, ou cria um com create() e o registra.
+     * @param create Chamada sem argumentos, devolve std::shared_ptr<T>; pode usar outros registros */
+    template<typename Create>
+    std::shared_ptr<T> acquire(const Key& key, Create&& create)
+    {
+        if (std::shared_ptr<T> live = find(key)) return live;
+        std::shared_ptr<T> value = create();
+        add(key, value);
+        return value;
+    }
+
+    /** Número de objetos distintos vivos no momento. */
+    [[nodiscard]] size_t liveCount() const
+    {
+        size_t live = 0;
+        for (const auto& entry : m_Entries) live += !entry.second.expired();
+        return live;
+    }
+
+private:
+    std::unordered_map<Key, std::weak_ptr<T>, Hash> m_Entries;
+};
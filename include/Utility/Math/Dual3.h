@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cmath>
+#include <glm/vec3.hpp>
+
+#include "Utility/Math/GenericVec3.h"
+
+namespace MathUtils
+{
+    /**
+     * @struct Dual3
+     * @brief Número dual com três derivadas parciais: v é o valor e d = (∂/∂x, ∂/∂y, ∂/∂z).
+     * Serve de escalar para as primitivas genéricas do CSGImplementable, de modo que uma única
+     * avaliação do SDF devolve a distância e o gradiente exato (diferenciação automática direta).
+     * Em min/max a derivada é a do argumento escolhido; empates ficam com o primeiro.
+     */
+    struct Dual3
+    {
+        float v;
+        glm::vec3 d;
+
+        Dual3() = default;
+        /** Constante: derivada nula. */
+        Dual3(const float value) : v(value), d(0.0f) {}
+        Dual3(const float value, const glm::vec3& derivative) : v(value), d(derivative) {}
+
+        friend Dual3 operator+(const Dual3& a, const Dual3& b) { return { a.v + b.v, a.d + b.d }; }
+        friend Dual3 operator-(const Dual3& a, const Dual3& b) { return { a.v - b.v, a.d - b.d }; }
+        friend Dual3 operator*(const Dual3& a, const Dual3& b) { return { a.v * b.v, a.d * b.v + b.d * a.v }; }
+        friend Dual3 operator/(const Dual3& a, const Dual3& b)
+        {
+            return { a.v / b.v, (a.d * b.v - b.d * a.v) / (b.v * b.v) };
+        }
+        friend Dual3 operator-(const Dual3& a) { return { -a.v, -a.d }; }
+
+        Dual3& operator+=(const Dual3& b) { return *this = *this + b; }
+        Dual3& operator-=(const Dual3& b) { return *this = *this - b; }
+        Dual3& operator*=(const Dual3& b) { return *this = *this * b; }
+
+        friend Dual3 min(const Dual3& a, const Dual3& b) { return b.v < a.v ? b : a; }
+        friend Dual3 max(const Dual3& a, const Dual3& b) { return b.v > a.v ? b : a; }
+        friend Dual3 abs(const Dual3& a) { return a.v < 0.0f ? -a : a; }
+
+        friend Dual3 sqrt(const Dual3& a)
+        {
+            // Em 0 a derivada diverge; usa 0, que é o valor certo para length(max(d, 0)) dentro da caixa
+            const float s = std::sqrt(a.v);
+            if (s <= 0.0f) return { s, glm::vec3(0.0f) };
+            return { s, a.d * (0.5f / s) };
+        }
+
+        friend Dual3 clamp(const Dual3& a, const Dual3& lo, const Dual3& hi)
+        {
+            return min(max(a, lo), hi);
+        }
+    };
+
+    using DualVec3 = GenericVec3<Dual3>;
+
+    /** Ponto semente da diferenciação: x, y e z com derivadas nos eixos canônicos. */
+    inline DualVec3 makeDualPoint(const glm::vec3& p)
+    {
+        return { Dual3(p.x, { 1.0f, 0.0f, 0.0f }), Dual3(p.y, { 0.0f, 1.0f, 0.0f }), Dual3(p.z, { 0.0f, 0.0f, 1.0f }) };
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <glm/vec3.hpp>
+
+namespace MathUtils
+{
+    /**
+     * @struct GenericVec3
+     * @brief Vetor 3D cujo escalar S é um tipo "float-like" (ex.: SIMD::FloatLanes).
+     * S precisa de +, -, *, /, construção a partir de float e min/max/abs/sqrt achados por ADL.
+     * As constantes das primitivas continuam em glm::vec3 e são promovidas nas operações mistas.
+     */
+    template<typename S>
+    struct GenericVec3
+    {
+        S x, y, z;
+
+        GenericVec3() = default;
+        GenericVec3(const S& x, const S& y, const S& z) : x(x), y(y), z(z) {}
+        explicit GenericVec3(const glm::vec3& v) : x(v.x), y(v.y), z(v.z) {}
+
+        friend GenericVec3 operator+(const GenericVec3& a, const GenericVec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        friend GenericVec3 operator-(const GenericVec3& a, const GenericVec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        friend GenericVec3 operator+(const GenericVec3& a, const glm::vec3& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        friend GenericVec3 operator-(const GenericVec3& a, const glm::vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        friend GenericVec3 operator-(const GenericVec3& a) { return { -a.x, -a.y, -a.z }; }
+        friend GenericVec3 operator*(const GenericVec3& a, const S& s) { return { a.x * s, a.y * s, a.z * s }; }
+
+        friend S dot(const GenericVec3& a, const GenericVec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        friend S dot(const GenericVec3& a, const glm::vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        friend S length(const GenericVec3& a)
+        {
+            using std::sqrt;
+            return sqrt(dot(a, a));
+        }
+
+        friend GenericVec3 abs(const GenericVec3& a)
+        {
+            using std::abs;
+            return { abs(a.x), abs(a.y), abs(a.z) };
+        }
+
+        friend GenericVec3 max(const GenericVec3& a, const float s)
+        {
+            using std::max;
+            return { max(a.x, S(s)), max(a.y, S(s)), max(a.z, S(s)) };
+        }
+    };
+}
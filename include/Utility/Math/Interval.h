@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/vec3.hpp>
+
+#include "Utility/Math/GenericVec3.h"
+
+namespace MathUtils
+{
+    /**
+     * @struct Interval
+     * @brief Aritmética intervalar: [lo, hi] contém todos os valores que a expressão assume quando as
+     * variáveis percorrem os próprios intervalos. Serve de escalar para as primitivas genéricas do
+     * CSGImplementable, de modo que uma avaliação do SDF sobre uma caixa devolve limites da distância
+     * na caixa inteira (conservadores: o intervalo pode ser maior que o alcance real, nunca menor).
+     */
+    struct Interval
+    {
+        float lo, hi;
+
+        Interval() = default;
+        /** Constante: intervalo degenerado. */
+        Interval(const float value) : lo(value), hi(value) {}
+        Interval(const float low, const float high) : lo(low), hi(high) {}
+
+        [[nodiscard]] bool contains(const float value) const { return lo <= value && value <= hi; }
+
+        friend Interval operator+(const Interval& a, const Interval& b) { return { a.lo + b.lo, a.hi + b.hi }; }
+        friend Interval operator-(const Interval& a, const Interval& b) { return { a.lo - b.hi, a.hi - b.lo }; }
+        friend Interval operator-(const Interval& a) { return { -a.hi, -a.lo }; }
+
+        friend Interval operator*(const Interval& a, const Interval& b)
+        {
+            // x * x (o mesmo objeto dos dois lados, como em dot(v, v)) nunca é negativo
+            if (&a == &b)
+            {
+                const float l = a.lo * a.lo, h = a.hi * a.hi;
+                if (a.lo >= 0.0f) return { l, h };
+                if (a.hi <= 0.0f) return { h, l };
+                return { 0.0f, std::max(l, h) };
+            }
+            const float p0 = a.lo * b.lo, p1 = a.lo * b.hi, p2 = a.hi * b.lo, p3 = a.hi * b.hi;
+            return { std::min(std::min(p0, p1), std::min(p2, p3)), std::max(std::max(p0, p1), std::max(p2, p3)) };
+        }
+
+        friend Interval operator/(const Interval& a, const Interval& b)
+        {
+            if (b.lo <= 0.0f && b.hi >= 0.0f)
+                return { -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+            return a * Interval(1.0f / b.hi, 1.0f / b.lo);
+        }
+
+        Interval& operator+=(const Interval& b) { return *this = *this + b; }
+        Interval& operator-=(const Interval& b) { return *this = *this - b; }
+        Interval& operator*=(const Interval& b) { return *this = *this * b; }
+
+        friend Interval min(const Interval& a, const Interval& b) { return { std::min(a.lo, b.lo), std::min(a.hi, b.hi) }; }
+        friend Interval max(const Interval& a, const Interval& b) { return { std::max(a.lo, b.lo), std::max(a.hi, b.hi) }; }
+
+        friend Interval abs(const Interval& a)
+        {
+            if (a.lo >= 0.0f) return a;
+            if (a.hi <= 0.0f) return -a;
+            return { 0.0f, std::max(-a.lo, a.hi) };
+        }
+
+        friend Interval sqrt(const Interval& a)
+        {
+            return { std::sqrt(std::max(a.lo, 0.0f)), std::sqrt(std::max(a.hi, 0.0f)) };
+        }
+
+        friend Interval clamp(const Interval& a, const Interval& lo, const Interval& hi)
+        {
+            return min(max(a, lo), hi);
+        }
+    };
+
+    using IntervalVec3 = GenericVec3<Interval>;
+
+    /** Caixa alinhada aos eixos [minCorner, maxCorner] como ponto intervalar. */
+    inline IntervalVec3 makeIntervalBox(const glm::vec3& minCorner, const glm::vec3& maxCorner)
+    {
+        return { Interval(minCorner.x, maxCorner.x), Interval(minCorner.y, maxCorner.y), Interval(minCorner.z, maxCorner.z) };
+    }
+}
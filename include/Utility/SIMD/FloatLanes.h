@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+// Seleção do conjunto de instruções em tempo de compilação:
+//  AVX/AVX2 -> 8 lanes (__m256), SSE2 -> 4 lanes (__m128), NEON (AArch64) -> 4 lanes (float32x4_t),
+//  qualquer outro alvo -> 4 lanes escalares.
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SIMD_LANES_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SIMD_LANES_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define SIMD_LANES_NEON 1
+#endif
+
+#include "Utility/Math/GenericVec3.h"
+
+namespace SIMD
+{
+    /**
+     * @struct FloatLanes
+     * @brief Pacote de Width floats processados juntos (SoA). Width é 8 com AVX e 4 nos demais alvos.
+     *
+     * Os operadores e as funções min/max/abs/sqrt/clamp são amigos ocultos, então valores float
+     * são promovidos (broadcast) automaticamente: `lanes * 0.5f`, `min(lanes, 0.0f)`.
+     */
+    struct FloatLanes
+    {
+#if defined(SIMD_LANES_AVX)
+        static constexpr int Width = 8;
+        using Native = __m256;
+#elif defined(SIMD_LANES_SSE)
+        static constexpr int Width = 4;
+        using Native = __m128;
+#elif defined(SIMD_LANES_NEON)
+        static constexpr int Width = 4;
+        using Native = float32x4_t;
+#else
+        static constexpr int Width = 4;
+        struct Native { float f[4]; };
+#endif
+
+        Native v;
+
+        FloatLanes() = default;
+        FloatLanes(const Native native) : v(native) {}
+
+        /** Broadcast de um escalar para todas as lanes. */
+        FloatLanes(const float s)
+        {
+#if defined(SIMD_LANES_AVX)
+            v = _mm256_set1_ps(s);
+#elif defined(SIMD_LANES_SSE)
+            v = _mm_set1_ps(s);
+#elif defined(SIMD_LANES_NEON)
+            v = vdupq_n_f32(s);
+#else
+            for (float& f : v.f) f = s;
+#endif
+        }
+
+        /** Carrega Width floats (sem exigência de alinhamento). */
+        static FloatLanes load(const float* p)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_loadu_ps(p);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_loadu_ps(p);
+#elif defined(SIMD_LANES_NEON)
+            return vld1q_f32(p);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = p[i];
+            return n;
+#endif
+        }
+
+        /** Grava Width floats (sem exigência de alinhamento). */
+        void store(float* p) const
+        {
+#if defined(SIMD_LANES_AVX)
+            _mm256_storeu_ps(p, v);
+#elif defined(SIMD_LANES_SSE)
+            _mm_storeu_ps(p, v);
+#elif defined(SIMD_LANES_NEON)
+            vst1q_f32(p, v);
+#else
+            for (int i = 0; i < Width; ++i) p[i] = v.f[i];
+#endif
+        }
+
+        friend FloatLanes operator+(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_add_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_add_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vaddq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] + b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes operator-(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_sub_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_sub_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vsubq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] - b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes operator*(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_mul_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_mul_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vmulq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] * b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes operator/(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_div_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_div_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vdivq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] / b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes operator-(const FloatLanes a)
+        {
+            return FloatLanes(0.0f) - a;
+        }
+
+        FloatLanes& operator+=(const FloatLanes b) { return *this = *this + b; }
+        FloatLanes& operator-=(const FloatLanes b) { return *this = *this - b; }
+        FloatLanes& operator*=(const FloatLanes b) { return *this = *this * b; }
+
+        friend FloatLanes min(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_min_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_min_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vminq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] < b.v.f[i] ? a.v.f[i] : b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes max(const FloatLanes a, const FloatLanes b)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_max_ps(a.v, b.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_max_ps(a.v, b.v);
+#elif defined(SIMD_LANES_NEON)
+            return vmaxq_f32(a.v, b.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = a.v.f[i] > b.v.f[i] ? a.v.f[i] : b.v.f[i];
+            return n;
+#endif
+        }
+
+        friend FloatLanes abs(const FloatLanes a)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);
+#elif defined(SIMD_LANES_NEON)
+            return vabsq_f32(a.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = std::fabs(a.v.f[i]);
+            return n;
+#endif
+        }
+
+        friend FloatLanes sqrt(const FloatLanes a)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_sqrt_ps(a.v);
+#elif defined(SIMD_LANES_SSE)
+            return _mm_sqrt_ps(a.v);
+#elif defined(SIMD_LANES_NEON)
+            return vsqrtq_f32(a.v);
+#else
+            Native n;
+            for (int i = 0; i < Width; ++i) n.f[i] = std::sqrt(a.v.f[i]);
+            return n;
+#endif
+        }
+
+        friend FloatLanes clamp(const FloatLanes a, const FloatLanes lo, const FloatLanes hi)
+        {
+            return min(max(a, lo), hi);
+        }
+
+        /** Máscara de bits das lanes menores que zero: bit l = (a[l] < 0). NaN conta como não negativo. */
+        friend int negativeMask(const FloatLanes a)
+        {
+#if defined(SIMD_LANES_AVX)
+            return _mm256_movemask_ps(_mm256_cmp_ps(a.v, _mm256_setzero_ps(), _CMP_LT_OQ));
+#elif defined(SIMD_LANES_SSE)
+            return _mm_movemask_ps(_mm_cmplt_ps(a.v, _mm_setzero_ps()));
+#elif defined(SIMD_LANES_NEON)
+            const uint32x4_t lt = vcltq_f32(a.v, vdupq_n_f32(0.0f));
+            const uint32x4_t bits = { 1u, 2u, 4u, 8u };
+            return static_cast<int>(vaddvq_u32(vandq_u32(lt, bits)));
+#else
+            int mask = 0;
+            for (int i = 0; i < Width; ++i) mask |= (a.v.f[i] < 0.0f ? 1 : 0) << i;
+            return mask;
+#endif
+        }
+    };
+
+    /** Vetor 3D com Width pontos por componente (x[0..W), y[0..W), z[0..W)). */
+    using Vec3Lanes = MathUtils::GenericVec3<FloatLanes>;
+
+    /**
+     * @brief Avalia `fn(const Vec3Lanes&) -> FloatLanes` sobre n pontos em SoA, Width por vez.
+     * A cauda (n % Width) é completada repetindo o último ponto; só as n saídas válidas são gravadas.
+     */
+    template<typename Fn>
+    void evaluateBatch(const float* xs, const float* ys, const float* zs, float* out, const size_t n, const Fn& fn)
+    {
+        constexpr size_t W = FloatLanes::Width;
+        size_t i = 0;
+        for (; i + W <= n; i += W)
+        {
+            const Vec3Lanes p{ FloatLanes::load(xs + i), FloatLanes::load(ys + i), FloatLanes::load(zs + i) };
+            fn(p).store(out + i);
+        }
+
+        if (i < n)
+        {
+            float tx[W], ty[W], tz[W], tout[W];
+            for (size_t l = 0; l < W; ++l)
+            {
+                const size_t src = (i + l < n) ? i + l : n - 1;
+                tx[l] = xs[src];
+                ty[l] = ys[src];
+                tz[l] = zs[src];
+            }
+            const Vec3Lanes p{ FloatLanes::load(tx), FloatLanes::load(ty), FloatLanes::load(tz) };
+            fn(p).store(tout);
+            for (size_t l = 0; i + l < n; ++l) out[i + l] = tout[l];
+        }
+    }
+}
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 #include "camera.h"
+#include "FrameUniforms.h"
+#include "RenderQueue.h"
 #include "Object/Meshes/Mesh.h"
 #include "window.h"
 #include "Scene/Scene.h"
@@ -64,6 +66,12 @@ public:
      * @param position Posição da luz
      */
     void setLightPosition(int lightIndex, const glm::vec3& position);
+
+    /**
+     * @brief Obtém os contadores do último frame desenhado
+     * @return Desenhos e trocas de programa, textura e geometria
+     */
+    const RenderQueue::Stats& getRenderStats() const { return m_renderQueue.getStats(); }
     
 private:
     /** @brief Configura as luzes iniciais*/
@@ -75,5 +83,11 @@ private:
     float m_accumulateTime = 0.0f;
 
     std::vector<Light> m_lights;
+
+    /** Câmera e luzes do frame, enviadas uma vez por frame para todos os programas. */
+    FrameUniforms::Buffers m_frameUniforms;
+
+    /** Desenhos do frame, ordenados por estado e profundidade. */
+    RenderQueue m_renderQueue;
 };
 #endif
\ No newline at end of file
@@ -13,12 +13,23 @@
 
 #include <glm/glm.hpp>
 
+#include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
+
+#include "ShaderRegistry.h"
 
 /**
  * @class Shader
  * @brief Classe para gerenciamento de shaders OpenGL
+ *
+ * O programa vem do ShaderRegistry: cópias e Shaders criados com os mesmos arquivos e defines usam o mesmo
+ * programa, apagado quando o último deles é destruído.
+ *
+ * Os uniforms são lidos do programa ao vinculá-lo. Para uso frequente, resolva o nome uma vez com uniform<T>()
+ * e envie com set(); os setters por nome (setInt...) procuram na mesma tabela. Nos dois casos o último valor
+ * de cada uniform fica guardado e um envio igual a ele não chega ao OpenGL.
  */
 class Shader
 {
@@ -30,14 +41,50 @@ public:
      * @brief Construtor que lê e constrói o shader
      * @param vertexPath Caminho para o arquivo do vertex shader
      * @param fragmentPath Caminho para o arquivo do fragment shader
+     * @param defines Defines do pré-processador ("NOME" ou "NOME VALOR") inseridos nos dois estágios
      */
-    Shader(const char* vertexPath, const char* fragmentPath);
+    Shader(const char* vertexPath, const char* fragmentPath, const std::vector<std::string>& defines = {});
 
     /**
-     * @brief Ativa o shader
+     * @brief Ativa o shader (nada é enviado se o programa já for o atual)
      */
     void use();
 
+    /**
+     * @brief Referência tipada a um uniform do programa, resolvida uma vez por uniform<T>()
+     *
+     * Inválida se o programa não tem o uniform; set() com ela não faz nada, como glUniform na localização -1.
+     */
+    template<typename T>
+    struct Uniform
+    {
+        int slot = -1;
+        bool valid() const { return slot >= 0; }
+    };
+
+    /**
+     * @brief Resolve um uniform pelo nome, sem chamar o OpenGL
+     * @param name Nome do uniform ("model", "material.diffuse", "lights[2].color"...)
+     * @return Referência para os set(); inválida se o programa não tem o uniform
+     */
+    template<typename T>
+    Uniform<T> uniform(const std::string& name) const
+    {
+        return Uniform<T>{ m_program ? m_program->slot(name) : -1 };
+    }
+
+    /**
+     * @brief Envia o valor de um uniform, se for diferente do último enviado ao programa. O programa tem que ser
+     * o atual (use).
+     */
+    void set(Uniform<bool> uniform, bool value) const;
+    void set(Uniform<int> uniform, int value) const;
+    void set(Uniform<float> uniform, float value) const;
+    void set(Uniform<glm::vec2> uniform, const glm::vec2& value) const;
+    void set(Uniform<glm::vec3> uniform, const glm::vec3& value) const;
+    void set(Uniform<glm::vec4> uniform, const glm::vec4& value) const;
+    void set(Uniform<glm::mat4> uniform, const glm::mat4& value) const;
+
     /**
      * @brief Define um valor booleano uniforme no shader
      * @param name Nome do uniforme
@@ -113,15 +160,16 @@ public:
      */
     std::string getFragmentPath() const;
 
+    /**
+     * @brief Obtém os defines com que o programa foi compilado
+     * @return Defines, na ordem em que foram passados
+     */
+    const std::vector<std::string>& getDefines() const;
+
 private:
     std::string m_vertexPath;   ///< Caminho para o arquivo do vertex shader
     std::string m_fragmentPath; ///< Caminho para o arquivo do fragment shader
-
-    /**
-     * @brief Verifica erros de compilação/vinculação de shader
-     * @param shader ID do shader ou programa
-     * @param type Tipo de verificação ("VERTEX", "FRAGMENT" ou "PROGRAM")
-     */
-    void checkCompileErrors(unsigned int shader, std::string type);
+    std::vector<std::string> m_defines; ///< Defines do pré-processador
+    std::shared_ptr<ShaderProgram> m_program; ///< Programa compartilhado do ShaderRegistry
 };
 #endif
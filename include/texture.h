@@ -9,11 +9,17 @@
 #endif
 
 #include <glad/glad.h>
+#include <memory>
 #include <string>
 
+#include "TextureRegistry.h"
+
 /**
  * @class Texture
  * @brief Classe para gerenciamento de texturas OpenGL
+ *
+ * A imagem vem do TextureRegistry: cópias e Textures carregados do mesmo arquivo com o mesmo SamplerState usam a
+ * mesma textura na GPU, apagada quando o último deles é destruído. Copiar um Texture é copiar uma referência.
  */
 class Texture {
 public:
@@ -28,28 +34,25 @@ public:
      */
     Texture(const std::string& filePath);
     
-    /**
-     * @brief Destrutor
-     */
-    ~Texture();
-    
     /**
      * @brief Carrega uma textura a partir de um arquivo
      * @param filePath Caminho para o arquivo de textura
+     * @param sampler Filtros e repetição da textura
      * @return true se o carregamento foi bem-sucedido, false caso contrário
      */
-    bool load(const std::string& filePath);
+    bool load(const std::string& filePath, const SamplerState& sampler = {});
     
     /**
-     * @brief Ativa a textura em uma unidade específica
+     * @brief Ativa a textura em uma unidade específica (nada é enviado se ela já estiver ligada lá)
      * @param unit Unidade de textura (padrão: 0)
      */
     void bind(unsigned int unit = 0) const;
     
     /**
      * @brief Desativa a textura
+     * @param unit Unidade de textura (padrão: 0)
      */
-    void unbind() const;
+    void unbind(unsigned int unit = 0) const;
     
     /**
      * @brief Obtém o ID da textura OpenGL
@@ -81,12 +84,16 @@ public:
      */
     std::string getFilePath() const;
 
+    /**
+     * @brief Obtém os filtros e a repetição da textura
+     * @return Estado do sampler com que a textura foi criada
+     */
+    const SamplerState& getSampler() const;
+
 private:
-    unsigned int m_id;       ///< ID da textura OpenGL
-    int m_width;             ///< Largura da textura em pixels
-    int m_height;            ///< Altura da textura em pixels
-    int m_channels;          ///< Número de canais da textura
-    std::string m_filePath;  ///< Caminho para o arquivo de textura
+    std::shared_ptr<TextureImage> m_image; ///< Textura compartilhada do TextureRegistry (nula antes do load)
+    SamplerState m_sampler;                ///< Filtros e repetição da textura
+    std::string m_filePath;                ///< Caminho para o arquivo de textura
 };
 
 #endif // TEXTURE_H
@@ -0,0 +1,569 @@
+#include "DualContouring/DualContouring.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <glm/trigonometric.hpp>
+#include <glm/vector_relational.hpp>
+
+using namespace DualContouring::Detail;
+
+namespace
+{
+    // Tabelas de contorno de Ju et al. ("Dual Contouring of Hermite Data", 2002). O índice c de filho/canto
+    // é ((x<<2) | (y<<1) | z); as arestas são numeradas como em EDGE_CORNERS.
+    constexpr int CELL_PROC_FACE_MASK[12][3] = {
+        {0,4,0},{1,5,0},{2,6,0},{3,7,0},{0,2,1},{4,6,1},{1,3,1},{5,7,1},{0,1,2},{2,3,2},{4,5,2},{6,7,2}
+    };
+    constexpr int CELL_PROC_EDGE_MASK[6][5] = {
+        {0,1,2,3,0},{4,5,6,7,0},{0,4,1,5,1},{2,6,3,7,1},{0,2,4,6,2},{1,3,5,7,2}
+    };
+    constexpr int FACE_PROC_FACE_MASK[3][4][3] = {
+        {{4,0,0},{5,1,0},{6,2,0},{7,3,0}},
+        {{2,0,1},{6,4,1},{3,1,1},{7,5,1}},
+        {{1,0,2},{3,2,2},{5,4,2},{7,6,2}}
+    };
+    constexpr int FACE_PROC_EDGE_MASK[3][4][6] = {
+        {{1,4,0,5,1,1},{1,6,2,7,3,1},{0,4,6,0,2,2},{0,5,7,1,3,2}},
+        {{0,2,3,0,1,0},{0,6,7,4,5,0},{1,2,0,6,4,2},{1,3,1,7,5,2}},
+        {{1,1,0,3,2,0},{1,5,4,7,6,0},{0,1,5,0,4,1},{0,3,7,2,6,1}}
+    };
+    constexpr int EDGE_PROC_EDGE_MASK[3][2][5] = {
+        {{3,2,1,0,0},{7,6,5,4,0}},
+        {{5,1,4,0,1},{7,3,6,2,1}},
+        {{6,4,2,0,2},{7,5,3,1,2}}
+    };
+    constexpr int PROCESS_EDGE_MASK[3][4] = { {3,2,1,0},{7,5,6,4},{11,10,9,8} };
+
+    constexpr int NO_NODE = -1;
+
+    glm::ivec3 CornerOffset(const int c) { return { (c>>2)&1, (c>>1)&1, c&1 }; }
+
+    // Uma célula colapsada tem um único vértice, então os cantos de dentro e os de fora precisam estar, cada grupo,
+    // conectados por arestas do cubo; senão a superfície precisaria de duas folhas nessa célula.
+    std::array<bool, 256> BuildManifoldTable()
+    {
+        std::array<bool, 256> table{};
+        for (int corners = 0; corners < 256; ++corners)
+        {
+            bool manifold = true;
+            for (int side = 0; side < 2 && manifold; ++side)
+            {
+                int members = 0;
+                for (int c = 0; c < 8; ++c)
+                    if (((corners >> c) & 1) == side) members |= 1 << c;
+                if (members == 0) continue;
+
+                int reached = members & -members;
+                for (bool grew = true; grew; )
+                {
+                    grew = false;
+                    for (const auto& edge : EDGE_CORNERS)
+                    {
+                        const int a = 1 << edge[0], b = 1 << edge[1];
+                        if ((members & a) && (members & b) && ((reached & a) != 0) != ((reached & b) != 0))
+                        {
+                            reached |= a | b;
+                            grew = true;
+                        }
+                    }
+                }
+                manifold = reached == members;
+            }
+            table[corners] = manifold;
+        }
+        return table;
+    }
+
+    // Autodecomposição 3x3 simétrica por rotações de Jacobi cíclicas: a vira diagonal, v guarda os autovetores
+    void JacobiEigen(double a[3][3], double v[3][3])
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                v[i][j] = i == j ? 1.0 : 0.0;
+
+        for (int sweep = 0; sweep < 8; ++sweep)
+        {
+            for (int p = 0; p < 2; ++p)
+            {
+                for (int q = p + 1; q < 3; ++q)
+                {
+                    if (std::abs(a[p][q]) < 1e-12) continue;
+                    const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                    const double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0), s = t * c;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const double akp = a[k][p], akq = a[k][q];
+                        a[k][p] = c * akp - s * akq;
+                        a[k][q] = s * akp + c * akq;
+                    }
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const double apk = a[p][k], aqk = a[q][k];
+                        a[p][k] = c * apk - s * aqk;
+                        a[q][k] = s * apk + c * aqk;
+                    }
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const double vkp = v[k][p], vkq = v[k][q];
+                        v[k][p] = c * vkp - s * vkq;
+                        v[k][q] = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+    }
+
+    // As normais são unitárias, então os autovalores de A^T A contam "planos" em cada direção; abaixo disto a
+    // direção é tratada como livre
+    constexpr double MIN_EIGENVALUE = 0.1;
+
+    // Número de direções de plano independentes na QEF: 1 numa região plana, 2 ao longo de uma aresta, 3 num canto
+    int QefRank(const Qef& qef)
+    {
+        double d[3][3] = {
+            { qef.ata[0], qef.ata[1], qef.ata[2] },
+            { qef.ata[1], qef.ata[3], qef.ata[4] },
+            { qef.ata[2], qef.ata[4], qef.ata[5] }
+        };
+        double v[3][3];
+        JacobiEigen(d, v);
+        int rank = 0;
+        for (int e = 0; e < 3; ++e) rank += d[e][e] >= MIN_EIGENVALUE;
+        return rank;
+    }
+
+    // Minimizador da QEF, resolvido em torno do centro de massa com uma pseudoinversa truncada, para que
+    // dados só de plano ou de aresta (posto 1 ou 2) fiquem perto do centro de massa em vez de fugirem
+    glm::vec3 SolveQef(const Qef& qef, float& error)
+    {
+        const glm::dvec3 mass = glm::dvec3(qef.massSum) / double(std::max(qef.count, 1));
+        double a[3][3] = {
+            { qef.ata[0], qef.ata[1], qef.ata[2] },
+            { qef.ata[1], qef.ata[3], qef.ata[4] },
+            { qef.ata[2], qef.ata[4], qef.ata[5] }
+        };
+        const glm::dvec3 atb(qef.atb);
+        glm::dvec3 rhs = atb;
+        for (int r = 0; r < 3; ++r)
+            rhs[r] -= a[r][0] * mass.x + a[r][1] * mass.y + a[r][2] * mass.z;
+
+        double v[3][3];
+        double d[3][3];
+        std::copy(&a[0][0], &a[0][0] + 9, &d[0][0]);
+        JacobiEigen(d, v);
+
+        glm::dvec3 x = mass;
+        for (int e = 0; e < 3; ++e)
+        {
+            if (d[e][e] < MIN_EIGENVALUE) continue;
+            const double proj = (v[0][e] * rhs.x + v[1][e] * rhs.y + v[2][e] * rhs.z) / d[e][e];
+            x += glm::dvec3(v[0][e], v[1][e], v[2][e]) * proj;
+        }
+
+        const glm::dvec3 ax(a[0][0] * x.x + a[0][1] * x.y + a[0][2] * x.z,
+                            a[1][0] * x.x + a[1][1] * x.y + a[1][2] * x.z,
+                            a[2][0] * x.x + a[2][1] * x.y + a[2][2] * x.z);
+        error = static_cast<float>(std::max(0.0, glm::dot(x, ax) - 2.0 * glm::dot(x, atb) + double(qef.btb)));
+        return glm::vec3(x);
+    }
+
+    struct Node
+    {
+        enum class Type { Internal, Pseudo, Leaf };
+
+        Type type = Type::Internal;
+        glm::ivec3 min{ 0 };
+        int size = 1;
+        int children[8] = { NO_NODE, NO_NODE, NO_NODE, NO_NODE, NO_NODE, NO_NODE, NO_NODE, NO_NODE };
+        uint8_t corners = 0;
+        Qef qef;
+        glm::vec3 normalSum{ 0.0f };
+        glm::vec3 position{ 0.0f };
+        unsigned int vertex = 0;
+    };
+
+    class OctreeMesher
+    {
+    public:
+        OctreeMesher(const std::vector<float>& grid, const Polygonizer::Detail::Lattice& lattice,
+            const DualContouring::Settings& settings)
+            : m_Grid(grid), m_Resolution(lattice.cells), m_Stride(lattice.nodes()),
+              m_MinCorner(lattice.minCorner), m_CellSize(lattice.cellSize), m_Settings(settings) {}
+
+        void build(std::vector<HermiteCell>& cells, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx)
+        {
+            if (cells.empty()) return;
+
+            int rootSize = 1;
+            while (rootSize < std::max(m_Resolution.x, std::max(m_Resolution.y, m_Resolution.z))) rootSize *= 2;
+
+            // A ordem de Morton deixa as células de cada nó da octree num intervalo contíguo
+            std::vector<std::pair<uint64_t, size_t>> order(cells.size());
+            for (size_t c = 0; c < cells.size(); ++c)
+                order[c] = { MortonCode(cells[c].cell), c };
+            std::sort(order.begin(), order.end());
+
+            m_Nodes.reserve(cells.size() * 2);
+            const int root = buildNode(cells, order, glm::ivec3(0), rootSize, 0, order.size());
+
+            const unsigned int firstVertex = static_cast<unsigned int>(outVerts.size() / 8);
+            assignVertices(root, outVerts);
+            const size_t firstIndex = outIdx.size();
+            cellProc(root, outIdx);
+            for (size_t i = firstIndex; i < outIdx.size(); ++i) outIdx[i] += firstVertex;
+
+            splitCreases(outVerts, outIdx, firstVertex, firstIndex);
+
+            if (m_Settings.invertFaceSide)
+                for (size_t i = firstIndex; i + 2 < outIdx.size(); i += 3)
+                    std::swap(outIdx[i + 1], outIdx[i + 2]);
+
+            if (m_Settings.stats)
+            {
+                m_Settings.stats->collapsedNodes = m_Collapsed;
+                m_Settings.stats->vertices = outVerts.size() / 8 - firstVertex;
+                m_Settings.stats->triangles = (outIdx.size() - firstIndex) / 3;
+            }
+        }
+
+    private:
+        const std::vector<float>& m_Grid;
+        glm::ivec3 m_Resolution;
+        glm::ivec3 m_Stride;
+        glm::vec3 m_MinCorner;
+        glm::vec3 m_CellSize;
+        const DualContouring::Settings& m_Settings;
+        std::vector<Node> m_Nodes;
+        size_t m_Collapsed = 0;
+
+        static uint64_t MortonCode(const glm::ivec3& c)
+        {
+            uint64_t code = 0;
+            for (int b = 0; b < 21; ++b)
+            {
+                code |= static_cast<uint64_t>((c.x >> b) & 1) << (3*b + 2);
+                code |= static_cast<uint64_t>((c.y >> b) & 1) << (3*b + 1);
+                code |= static_cast<uint64_t>((c.z >> b) & 1) << (3*b);
+            }
+            return code;
+        }
+
+        bool inside(const glm::ivec3& node) const
+        {
+            return m_Grid[node.x + static_cast<size_t>(m_Stride.x)*(node.y + static_cast<size_t>(m_Stride.y)*node.z)] < 0.0f;
+        }
+
+        glm::vec3 solve(const Node& node, float& error) const
+        {
+            if (node.qef.count == 0)
+            {
+                error = 0.0f;
+                return m_MinCorner + (glm::vec3(node.min) + 0.5f * float(node.size)) * m_CellSize;
+            }
+
+            glm::vec3 p = SolveQef(node.qef, error);
+
+            // Um vértice fora da sua célula pode dobrar a superfície; volta para o centro de massa
+            const glm::vec3 slack = 1e-3f * m_CellSize;
+            const glm::vec3 lo = m_MinCorner + glm::vec3(node.min) * m_CellSize - slack;
+            const glm::vec3 hi = m_MinCorner + glm::vec3(node.min + node.size) * m_CellSize + slack;
+            if (glm::any(glm::lessThan(p, lo)) || glm::any(glm::greaterThan(p, hi)))
+                p = node.qef.massSum / float(node.qef.count);
+            return p;
+        }
+
+        int buildNode(const std::vector<HermiteCell>& cells, const std::vector<std::pair<uint64_t, size_t>>& order,
+            const glm::ivec3& min, const int size, const size_t lo, const size_t hi)
+        {
+            Node node;
+            node.min = min;
+            node.size = size;
+
+            if (size == 1)
+            {
+                const HermiteCell& cell = cells[order[lo].second];
+                node.type = Node::Type::Leaf;
+                node.corners = cell.corners;
+                node.qef = cell.qef;
+                node.normalSum = cell.normalSum;
+                float error;
+                node.position = solve(node, error);
+                m_Nodes.push_back(node);
+                return static_cast<int>(m_Nodes.size() - 1);
+            }
+
+            const int half = size / 2;
+            int shift = 0;
+            while ((1 << shift) < half) ++shift;
+
+            bool collapsible = m_Settings.errorTolerance > 0.0f;
+            size_t begin = lo;
+            for (int c = 0; c < 8; ++c)
+            {
+                size_t end = begin;
+                while (end < hi && static_cast<int>((order[end].first >> (3*shift)) & 7) == c) ++end;
+                if (end > begin)
+                {
+                    node.children[c] = buildNode(cells, order, min + CornerOffset(c) * half, half, begin, end);
+                    collapsible &= m_Nodes[node.children[c]].type != Node::Type::Internal;
+                }
+                begin = end;
+            }
+
+            if (collapsible) tryCollapse(node);
+            m_Nodes.push_back(node);
+            return static_cast<int>(m_Nodes.size() - 1);
+        }
+
+        // Simplificação de Ju et al.: todos os filhos são folhas, a QEF combinada é plana e dentro da tolerância e
+        // a célula grossa mantém a topologia (configuração de sinais manifold, um só cruzamento por aresta grossa)
+        void tryCollapse(Node& node)
+        {
+            if (glm::any(glm::greaterThan(node.min + node.size, m_Resolution))) return;
+
+            uint8_t corners = 0;
+            for (int c = 0; c < 8; ++c)
+                if (inside(node.min + CornerOffset(c) * node.size)) corners |= static_cast<uint8_t>(1u << c);
+            static const std::array<bool, 256> manifold = BuildManifoldTable();
+            if (corners == 0 || corners == 0xFF || !manifold[corners]) return;
+
+            // Todo nó fino ao longo das 12 arestas grossas tem que manter o sinal do canto mais próximo até um único
+            // cruzamento; um segundo cruzamento (um entalhe ou fenda mais estreito que a célula) se perderia no colapso
+            for (const auto& edge : EDGE_CORNERS)
+            {
+                const glm::ivec3 a = node.min + CornerOffset(edge[0]) * node.size;
+                const glm::ivec3 step = CornerOffset(edge[1]) - CornerOffset(edge[0]);
+                int changes = 0;
+                bool previous = inside(a);
+                for (int t = 1; t <= node.size; ++t)
+                {
+                    const bool current = inside(a + step * t);
+                    changes += current != previous;
+                    previous = current;
+                }
+                if (changes > 1) return;
+            }
+
+            Qef qef;
+            glm::vec3 normalSum(0.0f);
+            for (const int child : node.children)
+            {
+                if (child == NO_NODE) continue;
+                qef.merge(m_Nodes[child].qef);
+                normalSum += m_Nodes[child].normalSum;
+            }
+            // Só regiões planas crescem: um vértice grosso numa aresta ou canto é ligado aos vizinhos por
+            // quads da largura da célula grossa, que cortam cantos côncavos (os entalhes do E)
+            if (QefRank(qef) > 1) return;
+
+            Node collapsed = node;
+            collapsed.qef = qef;
+            float error;
+            const glm::vec3 position = solve(collapsed, error);
+            if (error > m_Settings.errorTolerance) return;
+
+            node.type = Node::Type::Pseudo;
+            node.corners = corners;
+            node.qef = qef;
+            node.normalSum = normalSum;
+            node.position = position;
+            std::fill(std::begin(node.children), std::end(node.children), NO_NODE);
+            ++m_Collapsed;
+        }
+
+        void assignVertices(const int index, std::vector<float>& outVerts)
+        {
+            if (index == NO_NODE) return;
+            Node& node = m_Nodes[index];
+            if (node.type == Node::Type::Internal)
+            {
+                for (const int child : node.children) assignVertices(child, outVerts);
+                return;
+            }
+
+            const float len = glm::length(node.normalSum);
+            const glm::vec3 n = len > 0.0f ? node.normalSum / len : glm::vec3(0.0f, 0.0f, 1.0f);
+            node.vertex = static_cast<unsigned int>(outVerts.size() / 8);
+            outVerts.insert(outVerts.end(), {
+                node.position.x, node.position.y, node.position.z,
+                n.x, n.y, n.z,
+                0.0f, 0.0f
+            });
+        }
+
+        bool isLeaf(const int index) const { return m_Nodes[index].type != Node::Type::Internal; }
+
+        void processEdge(const int nodes[4], const int dir, std::vector<unsigned int>& outIdx) const
+        {
+            int minSize = 1 << 30;
+            int minIndex = 0;
+            bool flip = false;
+            bool signChange[4];
+            unsigned int ids[4];
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const Node& node = m_Nodes[nodes[i]];
+                const int edge = PROCESS_EDGE_MASK[dir][i];
+                const int s1 = (node.corners >> EDGE_CORNERS[edge][0]) & 1;
+                const int s2 = (node.corners >> EDGE_CORNERS[edge][1]) & 1;
+                if (node.size < minSize)
+                {
+                    minSize = node.size;
+                    minIndex = i;
+                    flip = s1 != 0;
+                }
+                ids[i] = node.vertex;
+                signChange[i] = s1 != s2;
+            }
+            if (!signChange[minIndex]) return;
+
+            // Quad 0-1-3-2 em volta da aresta; células colapsadas num só vértice geram triângulos degenerados
+            auto emit = [&](const unsigned int a, const unsigned int b, const unsigned int c)
+            {
+                if (a == b || b == c || a == c) return;
+                outIdx.insert(outIdx.end(), { a, b, c });
+            };
+            if (!flip)
+            {
+                emit(ids[0], ids[1], ids[3]);
+                emit(ids[0], ids[3], ids[2]);
+            }
+            else
+            {
+                emit(ids[0], ids[3], ids[1]);
+                emit(ids[0], ids[2], ids[3]);
+            }
+        }
+
+        void edgeProc(const int nodes[4], const int dir, std::vector<unsigned int>& outIdx) const
+        {
+            for (int i = 0; i < 4; ++i)
+                if (nodes[i] == NO_NODE) return;
+
+            if (isLeaf(nodes[0]) && isLeaf(nodes[1]) && isLeaf(nodes[2]) && isLeaf(nodes[3]))
+            {
+                processEdge(nodes, dir, outIdx);
+                return;
+            }
+
+            for (int i = 0; i < 2; ++i)
+            {
+                int edgeNodes[4];
+                for (int j = 0; j < 4; ++j)
+                    edgeNodes[j] = isLeaf(nodes[j]) ? nodes[j] : m_Nodes[nodes[j]].children[EDGE_PROC_EDGE_MASK[dir][i][j]];
+                edgeProc(edgeNodes, EDGE_PROC_EDGE_MASK[dir][i][4], outIdx);
+            }
+        }
+
+        void faceProc(const int nodes[2], const int dir, std::vector<unsigned int>& outIdx) const
+        {
+            if (nodes[0] == NO_NODE || nodes[1] == NO_NODE) return;
+            if (isLeaf(nodes[0]) && isLeaf(nodes[1])) return;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                int faceNodes[2];
+                for (int j = 0; j < 2; ++j)
+                    faceNodes[j] = isLeaf(nodes[j]) ? nodes[j] : m_Nodes[nodes[j]].children[FACE_PROC_FACE_MASK[dir][i][j]];
+                faceProc(faceNodes, FACE_PROC_FACE_MASK[dir][i][2], outIdx);
+            }
+
+            constexpr int ORDERS[2][4] = { { 0, 0, 1, 1 }, { 0, 1, 0, 1 } };
+            for (int i = 0; i < 4; ++i)
+            {
+                const int* mask = FACE_PROC_EDGE_MASK[dir][i];
+                const int* order = ORDERS[mask[0]];
+                int edgeNodes[4];
+                for (int j = 0; j < 4; ++j)
+                {
+                    const int node = nodes[order[j]];
+                    edgeNodes[j] = isLeaf(node) ? node : m_Nodes[node].children[mask[1 + j]];
+                }
+                edgeProc(edgeNodes, mask[5], outIdx);
+            }
+        }
+
+        void cellProc(const int index, std::vector<unsigned int>& outIdx) const
+        {
+            if (index == NO_NODE || isLeaf(index)) return;
+            const Node& node = m_Nodes[index];
+
+            for (const int child : node.children) cellProc(child, outIdx);
+
+            for (const auto& mask : CELL_PROC_FACE_MASK)
+            {
+                const int faceNodes[2] = { node.children[mask[0]], node.children[mask[1]] };
+                faceProc(faceNodes, mask[2], outIdx);
+            }
+
+            for (const auto& mask : CELL_PROC_EDGE_MASK)
+            {
+                const int edgeNodes[4] = { node.children[mask[0]], node.children[mask[1]], node.children[mask[2]], node.children[mask[3]] };
+                edgeProc(edgeNodes, mask[4], outIdx);
+            }
+        }
+
+        // Triângulos que se afastam mais que creaseAngleDeg da normal de um vértice ganham uma cópia própria do
+        // vértice, compartilhada com os outros triângulos daquele lado do vinco
+        void splitCreases(std::vector<float>& outVerts, std::vector<unsigned int>& outIdx,
+            const unsigned int firstVertex, const size_t firstIndex) const
+        {
+            if (m_Settings.creaseAngleDeg >= 180.0f) return;
+            const float cosCrease = std::cos(glm::radians(m_Settings.creaseAngleDeg));
+
+            auto position = [&](const unsigned int v) { return glm::vec3(outVerts[v*8], outVerts[v*8+1], outVerts[v*8+2]); };
+            auto normal = [&](const unsigned int v) { return glm::vec3(outVerts[v*8+3], outVerts[v*8+4], outVerts[v*8+5]); };
+
+            const size_t baseCount = outVerts.size() / 8 - firstVertex;
+            std::vector<int> firstCopy(baseCount, -1);       // por vértice original, início da sua lista de cópias
+            std::vector<int> nextCopy;                       // por cópia, a próxima cópia do mesmo vértice
+
+            for (size_t t = firstIndex; t + 2 < outIdx.size(); t += 3)
+            {
+                const glm::vec3 a = position(outIdx[t]), b = position(outIdx[t+1]), c = position(outIdx[t+2]);
+                glm::vec3 faceNormal = glm::cross(b - a, c - a);
+                const float len = glm::length(faceNormal);
+                if (len <= 0.0f) continue;
+                faceNormal /= len;
+                if (glm::dot(faceNormal, normal(outIdx[t]) + normal(outIdx[t+1]) + normal(outIdx[t+2])) < 0.0f)
+                    faceNormal = -faceNormal;
+
+                for (int m = 0; m < 3; ++m)
+                {
+                    const unsigned int v = outIdx[t + m];
+                    if (glm::dot(normal(v), faceNormal) >= cosCrease) continue;
+
+                    int copy = firstCopy[v - firstVertex];
+                    while (copy >= 0 && glm::dot(normal(static_cast<unsigned int>(copy)), faceNormal) < cosCrease)
+                        copy = nextCopy[copy - firstVertex - baseCount];
+
+                    if (copy < 0)
+                    {
+                        const glm::vec3 p = position(v);
+                        copy = static_cast<int>(outVerts.size() / 8);
+                        outVerts.insert(outVerts.end(), {
+                            p.x, p.y, p.z,
+                            faceNormal.x, faceNormal.y, faceNormal.z,
+                            0.0f, 0.0f
+                        });
+                        nextCopy.push_back(firstCopy[v - firstVertex]);
+                        firstCopy[v - firstVertex] = copy;
+                    }
+                    outIdx[t + m] = static_cast<unsigned int>(copy);
+                }
+            }
+        }
+    };
+}
+
+void DualContouring::Detail::BuildMesh(const std::vector<float>& grid, const Polygonizer::Detail::Lattice& lattice,
+    std::vector<HermiteCell>& cells, const Settings& settings,
+    std::vector<float>& outVerts, std::vector<unsigned int>& outIdx)
+{
+    OctreeMesher mesher(grid, lattice, settings);
+    mesher.build(cells, outVerts, outIdx);
+}
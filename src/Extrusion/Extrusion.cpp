@@ -0,0 +1,485 @@
+#include "Extrusion/Extrusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/trigonometric.hpp>
+
+using namespace Extrusion::Detail;
+
+namespace
+{
+    constexpr int NO_POINT = -1;
+    constexpr unsigned int NO_VERTEX = 0xFFFFFFFFu;
+
+    // O dobro da área com sinal do triângulo (a, b, c): > 0 quando anti-horário
+    double Cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+    {
+        return (double(b.x) - a.x) * (double(c.y) - a.y) - (double(b.y) - a.y) * (double(c.x) - a.x);
+    }
+
+    double SignedArea(const std::vector<glm::vec2>& pts, const std::vector<int>& loop)
+    {
+        double area = 0.0;
+        for (size_t k = 0, n = loop.size(); k < n; ++k) {
+            const glm::vec2& a = pts[loop[k]];
+            const glm::vec2& b = pts[loop[(k + 1) % n]];
+            area += double(a.x) * b.y - double(b.x) * a.y;
+        }
+        return 0.5 * area;
+    }
+
+    bool PointInLoop(const std::vector<glm::vec2>& pts, const std::vector<int>& loop, const glm::vec2& p)
+    {
+        bool inside = false;
+        for (size_t k = 0, n = loop.size(); k < n; ++k) {
+            const glm::vec2& a = pts[loop[k]];
+            const glm::vec2& b = pts[loop[(k + 1) % n]];
+            if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y))
+                inside = !inside;
+        }
+        return inside;
+    }
+
+    float DistanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b)
+    {
+        const glm::vec2 ab = b - a;
+        const float len2 = glm::dot(ab, ab);
+        const float t = len2 > 0.0f ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+        return glm::length(p - (a + t * ab));
+    }
+
+    // Onde as retas tangentes dos dois cruzamentos de uma célula se encontram, quando as normais diferem mais que o
+    // ângulo de vinco e o encontro fica dentro da célula: a quina viva que a interpolação linear cortou
+    bool SharpCorner(const glm::vec2& p0, const glm::vec2& n0, const glm::vec2& p1, const glm::vec2& n1,
+        const float cosCrease, const glm::vec2& cellMin, const glm::vec2& cellMax, glm::vec2& corner)
+    {
+        if (glm::dot(n0, n0) < 0.5f || glm::dot(n1, n1) < 0.5f) return false;
+        if (glm::dot(n0, n1) >= cosCrease) return false;
+
+        // Normais (quase) opostas: uma parede mais fina que a célula, não uma quina
+        const float det = n0.x * n1.y - n0.y * n1.x;
+        if (std::abs(det) < 1e-3f) return false;
+
+        const float d0 = glm::dot(n0, p0), d1 = glm::dot(n1, p1);
+        corner = glm::vec2((d0 * n1.y - d1 * n0.y) / det, (n0.x * d1 - n1.x * d0) / det);
+
+        const glm::vec2 margin = 1e-3f * (cellMax - cellMin);
+        return corner.x >= cellMin.x - margin.x && corner.x <= cellMax.x + margin.x
+            && corner.y >= cellMin.y - margin.y && corner.y <= cellMax.y + margin.y;
+    }
+
+    // Remove os pontos de um contorno fechado que ficam a menos de `tolerance` da corda entre os pontos mantidos
+    // em volta deles. O contorno começa no seu ponto mais baixo e à esquerda, que é sempre uma quina do seu fecho.
+    std::vector<int> SimplifyLoop(const std::vector<glm::vec2>& pts, std::vector<int> loop, const float tolerance)
+    {
+        const auto first = std::min_element(loop.begin(), loop.end(), [&](const int a, const int b)
+            { return pts[a].x < pts[b].x || (pts[a].x == pts[b].x && pts[a].y < pts[b].y); });
+        std::rotate(loop.begin(), first, loop.end());
+
+        const int n = static_cast<int>(loop.size());
+        std::vector<int> kept{ loop[0] };
+        for (int i = 0; i < n; ) {
+            int j = i + 1;
+            while (j < n) {
+                const glm::vec2& a = pts[loop[i]];
+                const glm::vec2& b = pts[loop[(j + 1) % n]];
+                bool fits = true;
+                for (int m = i + 1; m <= j && fits; ++m)
+                    fits = DistanceToSegment(pts[loop[m]], a, b) <= tolerance;
+                if (!fits) break;
+                ++j;
+            }
+            if (j < n) kept.push_back(loop[j]);
+            i = j;
+        }
+        return kept;
+    }
+
+    // Se a direção v->m sai da quina v (entre a e b de um polígono anti-horário) para dentro do polígono
+    bool LocallyInside(const glm::vec2& a, const glm::vec2& v, const glm::vec2& b, const glm::vec2& m)
+    {
+        if (Cross(a, v, b) >= 0.0)
+            return Cross(v, b, m) >= 0.0 && Cross(v, m, a) >= 0.0;
+        return !(Cross(v, a, m) > 0.0 && Cross(v, m, b) > 0.0);
+    }
+
+    // Liga os furos (horários) ao contorno externo (anti-horário) por pontes de largura zero
+    // (Eberly, "Triangulation by Ear Clipping"). Cada furo é ligado do seu ponto mais à direita a um ponto do
+    // polígono visível dali; os furos vão da direita para a esquerda, então um furo já ligado é só parte do polígono.
+    std::vector<int> BridgeHoles(const std::vector<glm::vec2>& pts, std::vector<int> polygon, std::vector<std::vector<int>> holes)
+    {
+        auto rightmost = [&](const std::vector<int>& loop)
+        {
+            return static_cast<int>(std::max_element(loop.begin(), loop.end(), [&](const int a, const int b)
+                { return pts[a].x < pts[b].x || (pts[a].x == pts[b].x && pts[a].y > pts[b].y); }) - loop.begin());
+        };
+        std::sort(holes.begin(), holes.end(), [&](const std::vector<int>& a, const std::vector<int>& b)
+            { return pts[a[rightmost(a)]].x > pts[b[rightmost(b)]].x; });
+
+        for (const auto& hole : holes) {
+            const int m = rightmost(hole);
+            const glm::vec2 M = pts[hole[m]];
+            const int n = static_cast<int>(polygon.size());
+            auto at = [&](const int k) -> const glm::vec2& { return pts[polygon[(k + n) % n]]; };
+
+            // Aresta do polígono mais próxima atingida pelo raio que sai de M para +X
+            int hitEdge = NO_POINT;
+            float hitX = std::numeric_limits<float>::max();
+            for (int k = 0; k < n; ++k) {
+                const glm::vec2& a = at(k);
+                const glm::vec2& b = at(k + 1);
+                if ((a.y > M.y) == (b.y > M.y)) continue;
+                const float x = a.x + (M.y - a.y) * (b.x - a.x) / (b.y - a.y);
+                if (x >= M.x && x < hitX) { hitX = x; hitEdge = k; }
+            }
+            if (hitEdge == NO_POINT) continue;
+
+            // A ponta da aresta mais à direita é visível, a não ser que um ponto reflexo dentro do triângulo
+            // (M, acerto, ponta) a esconda; aí o visível é o escondido de menor ângulo com o raio
+            int visible = at(hitEdge).x > at(hitEdge + 1).x ? hitEdge : (hitEdge + 1) % n;
+            const glm::vec2 hit(hitX, M.y);
+            const glm::vec2 P = at(visible);
+            const double triangle = Cross(M, hit, P);
+            float bestSlope = std::numeric_limits<float>::max(), bestDistance = bestSlope;
+            for (int k = 0; k < n && triangle != 0.0; ++k) {
+                const glm::vec2& R = at(k);
+                if (k == visible || R == P || R.x <= M.x) continue;
+                if (Cross(at(k - 1), R, at(k + 1)) >= 0.0) continue;
+                const double s0 = Cross(M, hit, R), s1 = Cross(hit, P, R), s2 = Cross(P, M, R);
+                const bool inside = triangle > 0.0 ? (s0 >= 0.0 && s1 >= 0.0 && s2 >= 0.0) : (s0 <= 0.0 && s1 <= 0.0 && s2 <= 0.0);
+                if (!inside) continue;
+
+                const float slope = std::abs(R.y - M.y) / (R.x - M.x);
+                const float distance = glm::length(R - M);
+                if (slope < bestSlope || (slope == bestSlope && distance < bestDistance)) {
+                    bestSlope = slope;
+                    bestDistance = distance;
+                    visible = k;
+                }
+            }
+
+            // Um ponto já usado por uma ponte aparece mais de uma vez; pega a cópia cuja quina abre para M
+            for (int k = 0; k < n; ++k) {
+                if (at(k) == at(visible) && LocallyInside(at(k - 1), at(k), at(k + 1), M)) {
+                    visible = k;
+                    break;
+                }
+            }
+
+            // polígono[..visível], M, resto do furo, M, polígono[visível..]
+            std::vector<int> bridged;
+            bridged.reserve(polygon.size() + hole.size() + 2);
+            bridged.insert(bridged.end(), polygon.begin(), polygon.begin() + visible + 1);
+            bridged.insert(bridged.end(), hole.begin() + m, hole.end());
+            bridged.insert(bridged.end(), hole.begin(), hole.begin() + m + 1);
+            bridged.insert(bridged.end(), polygon.begin() + visible, polygon.end());
+            polygon = std::move(bridged);
+        }
+        return polygon;
+    }
+
+    // Ear clipping de um polígono anti-horário (furos já ligados); acrescenta triângulos de ids de pontos
+    void EarClip(const std::vector<glm::vec2>& pts, const std::vector<int>& polygon, std::vector<int>& triangles)
+    {
+        const int n = static_cast<int>(polygon.size());
+        if (n < 3) return;
+
+        std::vector<int> prev(n), next(n);
+        for (int k = 0; k < n; ++k) {
+            prev[k] = (k + n - 1) % n;
+            next[k] = (k + 1) % n;
+        }
+        auto at = [&](const int k) -> const glm::vec2& { return pts[polygon[k]]; };
+        auto unlink = [&](const int k) { next[prev[k]] = next[k]; prev[next[k]] = prev[k]; };
+        auto emit = [&](const int k) { triangles.insert(triangles.end(), { polygon[prev[k]], polygon[k], polygon[next[k]] }); };
+
+        // Só pontos reflexos podem cair dentro do triângulo de uma quina convexa; cópias das quinas (pontes) não contam
+        auto isEar = [&](const int k)
+        {
+            const glm::vec2& a = at(prev[k]);
+            const glm::vec2& b = at(k);
+            const glm::vec2& c = at(next[k]);
+            if (Cross(a, b, c) <= 0.0) return false;
+
+            const glm::vec2 lo = glm::min(a, glm::min(b, c)), hi = glm::max(a, glm::max(b, c));
+            for (int q = next[next[k]]; q != prev[k]; q = next[q]) {
+                const glm::vec2& p = at(q);
+                if (p.x < lo.x || p.x > hi.x || p.y < lo.y || p.y > hi.y) continue;
+                if (p == a || p == b || p == c) continue;
+                if (Cross(a, b, p) >= 0.0 && Cross(b, c, p) >= 0.0 && Cross(c, a, p) >= 0.0
+                    && Cross(at(prev[q]), p, at(next[q])) <= 0.0)
+                    return false;
+            }
+            return true;
+        };
+
+        int remaining = n, k = 0, idle = 0;
+        while (remaining > 3) {
+            const glm::vec2& a = at(prev[k]);
+            const glm::vec2& b = at(k);
+            const glm::vec2& c = at(next[k]);
+            const double area = Cross(a, b, c);
+            const double scale = double(glm::dot(b - a, b - a)) + double(glm::dot(c - b, c - b));
+
+            // Ponto colinear ou repetido (p. ex. as pontas de uma ponte). O triângulo chato sai mesmo assim, a não ser
+            // que dois cantos dele sejam o mesmo ponto, para a tampa manter todo ponto do contorno que as paredes usam (sem junções em T).
+            if (std::abs(area) <= 1e-9 * scale) {
+                const int pa = polygon[prev[k]], pb = polygon[k], pc = polygon[next[k]];
+                if (pa != pb && pb != pc && pa != pc) emit(k);
+                const int after = next[k];
+                unlink(k);
+                --remaining;
+                k = after;
+                idle = 0;
+                continue;
+            }
+            if (isEar(k)) {
+                emit(k);
+                const int after = next[k];
+                unlink(k);
+                --remaining;
+                k = after;
+                idle = 0;
+                continue;
+            }
+
+            k = next[k];
+            if (++idle > remaining) {
+                // Nenhuma orelha (só com entrada degenerada): corta qualquer quina convexa para o laço terminar
+                int convex = k;
+                while (Cross(at(prev[convex]), at(convex), at(next[convex])) <= 0.0) {
+                    convex = next[convex];
+                    if (convex == k) return;
+                }
+                emit(convex);
+                k = next[convex];
+                unlink(convex);
+                --remaining;
+                idle = 0;
+            }
+        }
+        if (Cross(at(prev[k]), at(k), at(next[k])) > 0.0)
+            emit(k);
+    }
+}
+
+void Extrusion::Detail::FindCrossings(const Profile& profile, Crossings& crossings)
+{
+    const int stride = profile.stride();
+    const int rows = profile.rows();
+    crossings.xEdge.assign(static_cast<size_t>(stride) * rows, NO_POINT);
+    crossings.yEdge.assign(static_cast<size_t>(stride) * rows, NO_POINT);
+    crossings.edges.clear();
+    crossings.points.clear();
+
+    auto crossing = [&](const int a0, const int b0, const int a1, const int b1)
+    {
+        const float v0 = profile.value(a0, b0), v1 = profile.value(a1, b1);
+        if ((v0 < 0.0f) == (v1 < 0.0f)) return NO_POINT;
+        const glm::vec2 p0 = profile.node(a0, b0), p1 = profile.node(a1, b1);
+        const float t = v0 / (v0 - v1);
+        crossings.edges.push_back({ p0, p1, v0, v1 });
+        crossings.points.push_back(p0 + t * (p1 - p0));
+        return static_cast<int>(crossings.points.size() - 1);
+    };
+
+    for (int b = 0; b < rows; ++b) {
+        for (int a = 0; a < stride; ++a) {
+            const size_t node = a + static_cast<size_t>(stride) * b;
+            if (a + 1 < stride) crossings.xEdge[node] = crossing(a, b, a + 1, b);
+            if (b + 1 < rows)   crossings.yEdge[node] = crossing(a, b, a, b + 1);
+        }
+    }
+}
+
+void Extrusion::Detail::BuildMesh(const Profile& profile, const Crossings& crossings, const float zMin, const float zMax,
+    const Settings& settings, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx)
+{
+    const float cosCrease = settings.creaseAngleDeg >= 180.0f ? -2.0f : std::cos(glm::radians(settings.creaseAngleDeg));
+    const int stride = profile.stride();
+    const int rows = profile.rows();
+
+    // Pontos do contorno: os cruzamentos, depois as quinas reconstruídas
+    std::vector<glm::vec2> pts = crossings.points;
+    std::vector<glm::vec2> normals = crossings.normals;
+    const int crossingCount = static_cast<int>(pts.size());
+
+    // 1) Marching squares. Cada cruzamento começa exatamente um segmento (com o lado de dentro à esquerda, então os
+    //    contornos externos correm no sentido anti-horário e os furos no horário), talvez passando por uma quina reconstruída.
+    std::vector<int> next(crossingCount, NO_POINT), corner(crossingCount, NO_POINT);
+    for (int b = 0; b + 1 < rows; ++b) {
+        for (int a = 0; a + 1 < stride; ++a) {
+            const float v[4] = { profile.value(a, b), profile.value(a + 1, b), profile.value(a + 1, b + 1), profile.value(a, b + 1) };
+            int inside = 0;
+            for (int c = 0; c < 4; ++c)
+                if (v[c] < 0.0f) inside |= 1 << c;
+            if (inside == 0 || inside == 0xF) continue;
+
+            // Arestas da célula no sentido anti-horário: a aresta e vai do canto e ao canto (e+1)%4
+            const size_t node = a + static_cast<size_t>(stride) * b;
+            const int edgePoint[4] = { crossings.xEdge[node], crossings.yEdge[node + 1], crossings.xEdge[node + stride], crossings.yEdge[node] };
+            int ids[4];
+            bool leaving[4];
+            int count = 0;
+            for (int e = 0; e < 4; ++e) {
+                const bool in0 = (inside >> e) & 1, in1 = (inside >> ((e + 1) & 3)) & 1;
+                if (in0 == in1) continue;
+                ids[count] = edgePoint[e];
+                leaving[count] = in0;
+                ++count;
+            }
+
+            if (count == 2) {
+                const int from = leaving[0] ? ids[0] : ids[1];
+                const int to = leaving[0] ? ids[1] : ids[0];
+                next[from] = to;
+
+                // As células do anel só fecham o contorno ao longo da borda do domínio; ali não há quinas
+                const bool ring = a == 0 || b == 0 || a + 2 == stride || b + 2 == rows;
+                glm::vec2 c;
+                if (!ring && SharpCorner(pts[from], normals[from], pts[to], normals[to], cosCrease,
+                        profile.node(a, b), profile.node(a + 1, b + 1), c)) {
+                    corner[from] = static_cast<int>(pts.size());
+                    pts.push_back(c);
+                    normals.emplace_back(0.0f);
+                }
+            }
+            else {
+                // Sela: o centro da célula decide se os cantos de dentro ficam ligados (cada canto de fora é
+                // cortado pelo segmento até o próximo cruzamento) ou separados (cortados na direção do anterior)
+                const bool centerInside = v[0] + v[1] + v[2] + v[3] < 0.0f;
+                for (int q = 0; q < 4; ++q)
+                    if (leaving[q]) next[ids[q]] = ids[centerInside ? (q + 1) & 3 : (q + 3) & 3];
+            }
+        }
+    }
+
+    // 2) Contornos fechados, com os trechos retos juntados
+    const float tolerance = settings.simplifyTolerance * std::min(profile.cellSize.x, profile.cellSize.y);
+    std::vector<std::vector<int>> outers, holes;
+    std::vector<double> outerAreas;
+    std::vector<bool> visited(crossingCount, false);
+    size_t outlinePoints = 0;
+    for (int start = 0; start < crossingCount; ++start) {
+        if (visited[start] || next[start] == NO_POINT) continue;
+
+        std::vector<int> loop;
+        int p = start;
+        do {
+            visited[p] = true;
+            loop.push_back(p);
+            if (corner[p] != NO_POINT) loop.push_back(corner[p]);
+            p = next[p];
+        } while (p != NO_POINT && p != start && !visited[p]);
+        if (p != start) continue;
+
+        loop = SimplifyLoop(pts, std::move(loop), tolerance);
+        if (loop.size() < 3) continue;
+        const double area = SignedArea(pts, loop);
+        if (area == 0.0) continue;
+
+        outlinePoints += loop.size();
+        if (area > 0.0) {
+            outers.push_back(std::move(loop));
+            outerAreas.push_back(area);
+        }
+        else
+            holes.push_back(std::move(loop));
+    }
+
+    // Cada furo pertence ao menor contorno externo em volta dele
+    std::vector<std::vector<std::vector<int>>> holesOf(outers.size());
+    for (auto& hole : holes) {
+        int owner = NO_POINT;
+        for (int o = 0; o < static_cast<int>(outers.size()); ++o)
+            if (PointInLoop(pts, outers[o], pts[hole[0]]) && (owner == NO_POINT || outerAreas[o] < outerAreas[owner]))
+                owner = o;
+        if (owner != NO_POINT) holesOf[owner].push_back(hole);
+    }
+
+    // 3) Saída: pos(xyz), normal(xyz), UV(0,0)
+    const size_t vertsBefore = outVerts.size(), idxBefore = outIdx.size();
+    auto addVertex = [&](const glm::vec2& p, const float z, const glm::vec3& n)
+    {
+        const auto id = static_cast<unsigned int>(outVerts.size() / 8);
+        outVerts.insert(outVerts.end(), { p.x, p.y, z, n.x, n.y, n.z, 0.0f, 0.0f });
+        return id;
+    };
+    auto addTriangle = [&](const unsigned int a, const unsigned int b, const unsigned int c)
+    {
+        if (settings.invertFaceSide)
+            outIdx.insert(outIdx.end(), { a, c, b });
+        else
+            outIdx.insert(outIdx.end(), { a, b, c });
+    };
+
+    // Tampas: a mesma triangulação em zMax (virada para +Z) e, espelhada, em zMin
+    std::vector<unsigned int> topVertex(pts.size(), NO_VERTEX), bottomVertex(pts.size(), NO_VERTEX);
+    std::vector<int> triangles;
+    for (size_t o = 0; o < outers.size(); ++o) {
+        triangles.clear();
+        EarClip(pts, BridgeHoles(pts, outers[o], holesOf[o]), triangles);
+        for (const int p : triangles) {
+            if (topVertex[p] == NO_VERTEX) {
+                topVertex[p] = addVertex(pts[p], zMax, glm::vec3(0.0f, 0.0f, 1.0f));
+                bottomVertex[p] = addVertex(pts[p], zMin, glm::vec3(0.0f, 0.0f, -1.0f));
+            }
+        }
+        for (size_t t = 0; t < triangles.size(); t += 3) {
+            const int a = triangles[t], b = triangles[t + 1], c = triangles[t + 2];
+            addTriangle(topVertex[a], topVertex[b], topVertex[c]);
+            addTriangle(bottomVertex[a], bottomVertex[c], bottomVertex[b]);
+        }
+    }
+
+    // Paredes: um quad por segmento do contorno. Um ponto onde os segmentos viram mais que o ângulo de vinco ganha um
+    // par de vértices por segmento, com a normal desse segmento; nos outros o par é compartilhado e usa a normal do SDF.
+    auto addWalls = [&](const std::vector<int>& loop)
+    {
+        const int n = static_cast<int>(loop.size());
+        std::vector<glm::vec3> face(n);
+        for (int k = 0; k < n; ++k) {
+            const glm::vec2 d = pts[loop[(k + 1) % n]] - pts[loop[k]];
+            face[k] = glm::vec3(glm::normalize(glm::vec2(d.y, -d.x)), 0.0f);
+        }
+
+        std::vector<unsigned int> shared(n, NO_VERTEX);
+        std::vector<bool> sharp(n);
+        for (int k = 0; k < n; ++k) {
+            const glm::vec3& before = face[(k + n - 1) % n];
+            sharp[k] = glm::dot(before, face[k]) < cosCrease;
+            if (sharp[k]) continue;
+
+            const glm::vec2& g = normals[loop[k]];
+            const glm::vec3 smooth = glm::dot(g, g) > 0.5f ? glm::vec3(g, 0.0f) : glm::normalize(before + face[k]);
+            shared[k] = addVertex(pts[loop[k]], zMin, smooth);
+            addVertex(pts[loop[k]], zMax, smooth);
+        }
+
+        for (int k = 0; k < n; ++k) {
+            const int l = (k + 1) % n;
+            const unsigned int p = sharp[k] ? addVertex(pts[loop[k]], zMin, face[k]) : shared[k];
+            if (sharp[k]) addVertex(pts[loop[k]], zMax, face[k]);
+            const unsigned int q = sharp[l] ? addVertex(pts[loop[l]], zMin, face[k]) : shared[l];
+            if (sharp[l]) addVertex(pts[loop[l]], zMax, face[k]);
+
+            // id do vértice de baixo, id do de cima + 1
+            addTriangle(p, q, q + 1);
+            addTriangle(p, q + 1, p + 1);
+        }
+    };
+    for (const auto& loop : outers) addWalls(loop);
+    for (const auto& loop : holes) addWalls(loop);
+
+    if (settings.stats) {
+        Stats& stats = *settings.stats;
+        stats.contourPoints = static_cast<size_t>(crossingCount);
+        stats.cornerPoints = pts.size() - static_cast<size_t>(crossingCount);
+        stats.outlinePoints = outlinePoints;
+        stats.loops = outers.size() + holes.size();
+        stats.vertices = (outVerts.size() - vertsBefore) / 8;
+        stats.triangles = (outIdx.size() - idxBefore) / 3;
+    }
+}
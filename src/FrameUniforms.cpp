@@ -0,0 +1,64 @@
+#include "FrameUniforms.h"
+
+#include <algorithm>
+#include <glad/glad.h>
+
+void FrameUniforms::BindBlocks(const unsigned int program)
+{
+    const GLuint camera = glGetUniformBlockIndex(program, "Camera");
+    if (camera != GL_INVALID_INDEX) glUniformBlockBinding(program, camera, CAMERA_BINDING);
+
+    const GLuint lights = glGetUniformBlockIndex(program, "Lights");
+    if (lights != GL_INVALID_INDEX) glUniformBlockBinding(program, lights, LIGHTS_BINDING);
+}
+
+FrameUniforms::Buffers::~Buffers()
+{
+    if (m_lights) glDeleteBuffers(1, &m_lights);
+    if (m_camera) glDeleteBuffers(1, &m_camera);
+}
+
+void FrameUniforms::Buffers::create()
+{
+    if (m_camera) return;
+
+    glGenBuffers(1, &m_camera);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_camera);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, m_camera);
+
+    glGenBuffers(1, &m_lights);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_lights);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightsBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTS_BINDING, m_lights);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::Buffers::update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos,
+    const std::vector<Light>& lights)
+{
+    CameraBlock camera;
+    camera.view = view;
+    camera.projection = projection;
+    camera.viewPos = viewPos;
+
+    LightsBlock block;
+    const size_t count = std::min(lights.size(), static_cast<size_t>(EngineLimits::MAX_LIGHTS));
+    for (size_t i = 0; i < count; ++i)
+    {
+        LightStd140& out = block.lights[i];
+        out.position = lights[i].position;
+        out.color = lights[i].color;
+        out.constant = lights[i].constant;
+        out.linear = lights[i].linear;
+        out.quadratic = lights[i].quadratic;
+    }
+
+    // Orphaning do buffer inteiro: o driver pode entregar armazenamento novo em vez de esperar os desenhos do frame anterior
+    glBindBuffer(GL_UNIFORM_BUFFER, m_camera);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), &camera, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_lights);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightsBlock), &block, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
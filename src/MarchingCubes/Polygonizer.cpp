@@ -1,110 +1,143 @@
 #include "MarchingCubes/Polygonizer.h"
 
-#include <glm/geometric.hpp>
+#include "optimization.h"
 
-#include "MarchingCubes/MarchingCubesTable.h"
+namespace
+{
+    // Pool de threads dividido por todas as poligonizações do processo.
+    ThreadPool& GetThreadPool()
+    {
+        static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+        return pool;
+    }
 
-// Linear interpolation on edge between p1,p2 with SDF values v1,v2
-static glm::vec3 vertexInterp(const glm::vec3& p1, const glm::vec3& p2, float v1, float v2) {
-    float t = v1 / (v1 - v2);
-    return p1 + t * (p2 - p1);
+    // Marcada nas threads do pool: um ParallelFor aninhado roda na própria thread em vez de travar o pool.
+    thread_local bool t_IsPoolWorker = false;
 }
 
-void Polygonizer::PolygonizeSurface(const std::function<float(const glm::vec3&)>& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
-    int resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, bool invertFaceSide)
+unsigned int Polygonizer::Detail::ResolveThreadCount(const unsigned int requested)
 {
-    glm::vec3 size = maxCorner - minCorner;
-    float dx = size.x / float(resolution);
-    float dy = size.y / float(resolution);
-    float dz = size.z / float(resolution);
-
-    // 1) Sample SDF on (resolution+1)^3 grid
-    int stride = resolution + 1;
-    std::vector<float> grid(stride*stride*stride);
-    auto idx3 = [&](int i, int j, int k){ return i + stride*(j + stride*k); };
-
-    for(int k = 0; k <= resolution; ++k) {
-        for(int j = 0; j <= resolution; ++j) {
-            for(int i = 0; i <= resolution; ++i) {
-                glm::vec3 p = minCorner + glm::vec3(i*dx, j*dy, k*dz);
-                grid[idx3(i,j,k)] = sdf(p);
-            }
-        }
+    if (requested != 0) return requested;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// As tarefas saem de um contador comum, então tarefas de tamanhos diferentes ainda se dividem bem entre as threads.
+void Polygonizer::Detail::ParallelFor(const int count, const unsigned int threads, const std::function<void(int)>& job)
+{
+    if (threads <= 1 || count <= 1 || t_IsPoolWorker)
+    {
+        for (int i = 0; i < count; ++i) job(i);
+        return;
     }
 
-    // 2) Marching Cubes over each cell
-    for(int k = 0; k < resolution; ++k) {
-        for(int j = 0; j < resolution; ++j) {
-            for(int i = 0; i < resolution; ++i) {
-                // corner indices & positions & values
-                int cornerIdx[8] = {
-                    idx3(i  ,j  ,k),
-                    idx3(i+1,j  ,k),
-                    idx3(i+1,j+1,k),
-                    idx3(i  ,j+1,k),
-                    idx3(i  ,j  ,k+1),
-                    idx3(i+1,j  ,k+1),
-                    idx3(i+1,j+1,k+1),
-                    idx3(i  ,j+1,k+1)
-                };
-                glm::vec3 pos[8];
-                float val[8];
-                for(int c = 0; c < 8; ++c) {
-                    val[c] = grid[cornerIdx[c]];
-                    int xi = i + ((c==1||c==2||c==5||c==6)?1:0);
-                    int yj = j + ((c>=2&&c<=3)||(c>=6&&c<=7)?1:0);
-                    int zk = k + (c>=4?1:0);
-                    pos[c] = minCorner + glm::vec3(xi*dx, yj*dy, zk*dz);
-                }
-
-                // build cubeIndex
-                int cubeIndex = 0;
-                for(int c = 0; c < 8; ++c)
-                    if(val[c] < 0.0f) cubeIndex |= (1<<c);
-                int edges = MarchingCubes::EDGE_TABLE[cubeIndex];
-                if(edges == 0) continue;
-
-                // interpolate vertices on each intersected edge
-                glm::vec3 vertList[12];
-                if(edges & 1)   vertList[0]  = vertexInterp(pos[0], pos[1], val[0], val[1]);
-                if(edges & 2)   vertList[1]  = vertexInterp(pos[1], pos[2], val[1], val[2]);
-                if(edges & 4)   vertList[2]  = vertexInterp(pos[2], pos[3], val[2], val[3]);
-                if(edges & 8)   vertList[3]  = vertexInterp(pos[3], pos[0], val[3], val[0]);
-                if(edges & 16)  vertList[4]  = vertexInterp(pos[4], pos[5], val[4], val[5]);
-                if(edges & 32)  vertList[5]  = vertexInterp(pos[5], pos[6], val[5], val[6]);
-                if(edges & 64)  vertList[6]  = vertexInterp(pos[6], pos[7], val[6], val[7]);
-                if(edges & 128) vertList[7]  = vertexInterp(pos[7], pos[4], val[7], val[4]);
-                if(edges & 256) vertList[8]  = vertexInterp(pos[0], pos[4], val[0], val[4]);
-                if(edges & 512) vertList[9]  = vertexInterp(pos[1], pos[5], val[1], val[5]);
-                if(edges & 1024)vertList[10] = vertexInterp(pos[2], pos[6], val[2], val[6]);
-                if(edges & 2048)vertList[11] = vertexInterp(pos[3], pos[7], val[3], val[7]);
-
-                // generate triangles
-                for(int t = 0; MarchingCubes::TRI_TABLE[cubeIndex][t] != -1; t += 3) {
-                    unsigned int base = outVerts.size() / 8;
-                    for(int m = 0; m < 3; ++m) {
-                        glm::vec3 v = vertList[ MarchingCubes::TRI_TABLE[cubeIndex][t + m] ];
-                        // approximate normal via central difference
-                        const float eps = 1e-3f;
-                        glm::vec3 n = glm::normalize(glm::vec3(
-                            sdf(v + glm::vec3(eps,0,0)) - sdf(v - glm::vec3(eps,0,0)),
-                            sdf(v + glm::vec3(0,eps,0)) - sdf(v - glm::vec3(0,eps,0)),
-                            sdf(v + glm::vec3(0,0,eps)) - sdf(v - glm::vec3(0,0,eps))
-                        ));
-                        
-                        // push: pos(xyz), normal(xyz), UV(0,0)
-                        outVerts.insert(outVerts.end(), {
-                            v.x, v.y, v.z,
-                            n.x, n.y, n.z,
-                            0.0f, 0.0f
-                        });
+    std::atomic<int> next{0};
+    auto worker = [&]()
+    {
+        t_IsPoolWorker = true;
+        for (int i = next++; i < count; i = next++) job(i);
+        t_IsPoolWorker = false;
+    };
+
+    const unsigned int taskCount = std::min(threads, static_cast<unsigned int>(count));
+    std::vector<std::future<void>> results;
+    results.reserve(taskCount);
+    for (unsigned int t = 0; t < taskCount; ++t)
+        results.emplace_back(GetThreadPool().enqueue(worker));
+
+    for (auto& result : results) result.get();
+}
+
+void Polygonizer::Detail::FillCulledNodes(const BlockGrid& blocks, const glm::ivec3& cells, std::vector<float>& grid)
+{
+    const size_t strideX = static_cast<size_t>(cells.x) + 1;
+    const size_t strideY = static_cast<size_t>(cells.y) + 1;
+    for (int bk = 0; bk < blocks.count.z; ++bk)
+        for (int bj = 0; bj < blocks.count.y; ++bj)
+            for (int bi = 0; bi < blocks.count.x; ++bi)
+            {
+                const char state = blocks.active[blocks.index(bi, bj, bk)];
+                if (state == BLOCK_ACTIVE) continue;
+
+                const float value = state == BLOCK_INSIDE ? -1.0f : 1.0f;
+                const int i1 = std::min(cells.x, (bi + 1) * blocks.blockSize);
+                const int j1 = std::min(cells.y, (bj + 1) * blocks.blockSize);
+                const int k1 = std::min(cells.z, (bk + 1) * blocks.blockSize);
+                for (int k = bk * blocks.blockSize; k <= k1; ++k)
+                    for (int j = bj * blocks.blockSize; j <= j1; ++j)
+                    {
+                        float* row = &grid[strideX * (j + strideY * k)];
+                        std::fill(row + bi * blocks.blockSize, row + i1 + 1, value);
                     }
-                    if (invertFaceSide)
-                        outIdx.insert(outIdx.end(), { base, base+1, base+2 });
-                    else
-                        outIdx.insert(outIdx.end(), { base, base+2, base+1 });
-                }
             }
+}
+
+void Polygonizer::Detail::MirrorMesh(std::vector<float>& verts, std::vector<unsigned int>& idx, const size_t firstVertex,
+    const size_t firstIndex, const int axis, const float plane)
+{
+    const size_t vertexEnd = verts.size() / 8;
+    std::vector<unsigned int> mirrored(vertexEnd - firstVertex);
+    verts.reserve(verts.size() + 8 * mirrored.size());
+    for (size_t v = firstVertex; v < vertexEnd; ++v) {
+        // Os vértices da costura vêm de arestas da grade deitadas no plano (ou de cruzamentos bem num nó do plano),
+        // então a coordenada deles é a do próprio plano, bit a bit; numa superfície simétrica a normal ali é tangente a ele
+        if (verts[8*v + axis] == plane) {
+            float* n = &verts[8*v + 3];
+            const float tangent = n[axis];
+            n[axis] = 0.0f;
+            const float len = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+            if (len > 1e-6f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+            else n[axis] = tangent;
+            mirrored[v - firstVertex] = static_cast<unsigned int>(v);
+            continue;
         }
+
+        mirrored[v - firstVertex] = static_cast<unsigned int>(verts.size() / 8);
+        for (int c = 0; c < 8; ++c) verts.push_back(verts[8*v + c]);
+        float* copy = &verts[verts.size() - 8];
+        copy[axis] = 2.0f * plane - copy[axis];
+        copy[3 + axis] = -copy[3 + axis];
+    }
+
+    // Uma reflexão vira todo triângulo do avesso; trocar dois cantos o desvira
+    const size_t indexEnd = idx.size();
+    idx.reserve(idx.size() + (indexEnd - firstIndex));
+    for (size_t t = firstIndex; t + 2 < indexEnd; t += 3) {
+        const unsigned int a = mirrored[idx[t] - firstVertex];
+        const unsigned int b = mirrored[idx[t + 1] - firstVertex];
+        const unsigned int c = mirrored[idx[t + 2] - firstVertex];
+        idx.insert(idx.end(), { a, c, b });
     }
 }
+
+glm::ivec3 Polygonizer::CellsForVoxelSize(const glm::vec3& minCorner, const glm::vec3& maxCorner, const float voxelSize)
+{
+    // Uma folga mínima para que uma extensão múltipla exata do voxel não arredonde para uma célula a mais
+    const glm::vec3 cells = glm::ceil((maxCorner - minCorner) / voxelSize - 1e-4f);
+    return glm::max(glm::ivec3(cells), glm::ivec3(1));
+}
+
+glm::ivec3 Polygonizer::IsotropicCells(const glm::vec3& minCorner, const glm::vec3& maxCorner, const int resolution)
+{
+    const glm::vec3 extent = maxCorner - minCorner;
+    const float longest = std::max(extent.x, std::max(extent.y, extent.z));
+    glm::ivec3 cells = CellsForVoxelSize(minCorner, maxCorner, longest / float(resolution));
+    // O eixo mais longo fica com exatamente `resolution`, seja qual for o arredondamento de longest / resolution
+    for (int a = 0; a < 3; ++a)
+        if (extent[a] == longest) cells[a] = resolution;
+    return cells;
+}
+
+void Polygonizer::PolygonizeSurface(const std::function<float(const glm::vec3&)>& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    int resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, bool invertFaceSide)
+{
+    Settings settings;
+    settings.invertFaceSide = invertFaceSide;
+    PolygonizeSurface(sdf, minCorner, maxCorner, resolution, outVerts, outIdx, settings);
+}
+
+void Polygonizer::PolygonizeSurface(const std::function<float(const glm::vec3&)>& sdf, const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    int resolution, std::vector<float>& outVerts, std::vector<unsigned int>& outIdx, const Settings& settings)
+{
+    // Só repassa: a versão genérica, com a std::function como callable
+    PolygonizeSurface<std::function<float(const glm::vec3&)>>(sdf, minCorner, maxCorner, resolution, outVerts, outIdx, settings);
+}
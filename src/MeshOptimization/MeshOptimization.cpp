@@ -0,0 +1,277 @@
+#include "MeshOptimization/MeshOptimization.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+namespace
+{
+    constexpr unsigned int NO_VERTEX = 0xFFFFFFFFu;
+
+    // Cache pós-transformação FIFO: um vértice fica no cache enquanto houver menos de `size` faltas desde a dele
+    struct FifoCache
+    {
+        std::vector<uint64_t> stamp;
+        uint64_t time;
+        unsigned int size;
+
+        FifoCache(const size_t vertexCount, const unsigned int cacheSize)
+            : stamp(vertexCount, 0), time(uint64_t(cacheSize) + 1), size(cacheSize) {}
+
+        // Esquece todos os vértices, como faria um novo desenho ou uma fronteira de cluster
+        void flush() { time += size + 1; }
+
+        // Retorna se o vértice precisou ser transformado
+        bool access(const unsigned int v)
+        {
+            if (time - stamp[v] <= size) return false;
+            stamp[v] = time++;
+            return true;
+        }
+    };
+
+    // Triângulos em volta de cada vértice, como deslocamentos numa lista única
+    struct Adjacency
+    {
+        std::vector<unsigned int> offsets, triangles, live;
+
+        Adjacency(const std::vector<unsigned int>& indices, const size_t vertexCount)
+            : offsets(vertexCount + 1, 0), triangles(indices.size()), live(vertexCount, 0)
+        {
+            for (const unsigned int v : indices) ++live[v];
+            for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + live[v];
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) triangles[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    };
+
+    // Tipsify (Sander, Nehab & Barczak 2007): abre um leque a partir do vértice atual, depois passa para o vizinho que
+    // ainda vai estar no cache depois de emitir os próprios triângulos restantes. Retorna a nova ordem dos triângulos e,
+    // em `hardBoundaries`, as posições onde precisou pular para um vértice sem relação (ali o cache está frio).
+    std::vector<unsigned int> Tipsify(const std::vector<unsigned int>& indices, const size_t vertexCount, const unsigned int cacheSize,
+        std::vector<size_t>& hardBoundaries)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        Adjacency adjacency(indices, vertexCount);
+        std::vector<unsigned int>& live = adjacency.live;
+
+        std::vector<uint64_t> stamp(vertexCount, 0);
+        uint64_t time = uint64_t(cacheSize) + 1;
+        std::vector<char> emitted(triangleCount, 0);
+        std::vector<unsigned int> deadEnds, candidates, order;
+        order.reserve(triangleCount);
+        deadEnds.reserve(indices.size());
+
+        size_t cursor = 0;
+        auto skipDeadEnd = [&]() -> unsigned int
+        {
+            // Primeiro os vértices usados há pouco, depois o próximo na ordem de entrada que ainda tem triângulos
+            while (!deadEnds.empty()) {
+                const unsigned int d = deadEnds.back();
+                deadEnds.pop_back();
+                if (live[d] > 0) return d;
+            }
+            for (; cursor < vertexCount; ++cursor)
+                if (live[cursor] > 0) return static_cast<unsigned int>(cursor);
+            return NO_VERTEX;
+        };
+
+        unsigned int fan = skipDeadEnd();
+        while (fan != NO_VERTEX) {
+            candidates.clear();
+            for (unsigned int a = adjacency.offsets[fan]; a < adjacency.offsets[fan + 1]; ++a) {
+                const unsigned int t = adjacency.triangles[a];
+                if (emitted[t]) continue;
+                emitted[t] = 1;
+                order.push_back(t);
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int v = indices[t * 3 + k];
+                    deadEnds.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - stamp[v] > cacheSize) stamp[v] = time++;
+                }
+            }
+
+            // O candidato mais antigo que continua no cache durante os próprios triângulos restantes (cada um pode custar
+            // duas faltas); se nenhum continua, o leque acaba e a pilha de becos sem saída escolhe o próximo
+            unsigned int next = NO_VERTEX;
+            uint64_t bestAge = 0;
+            for (const unsigned int v : candidates) {
+                if (live[v] == 0) continue;
+                uint64_t age = 0;
+                if (time - stamp[v] + 2 * uint64_t(live[v]) <= cacheSize) age = time - stamp[v];
+                if (age > bestAge) {
+                    bestAge = age;
+                    next = v;
+                }
+            }
+            if (next == NO_VERTEX) {
+                next = skipDeadEnd();
+                if (next != NO_VERTEX && order.size() < triangleCount) hardBoundaries.push_back(order.size());
+            }
+            fan = next;
+        }
+        return order;
+    }
+
+    // Divide mais os clusters rígidos onde o ACMR corrente do pedaço já está a menos de `threshold` do ACMR do
+    // cluster inteiro, então recomeçar o cache custa pouco (as fronteiras suaves de Sander et al.)
+    std::vector<size_t> SoftBoundaries(const std::vector<unsigned int>& indices, const size_t vertexCount, const unsigned int cacheSize,
+        const std::vector<size_t>& hardBoundaries, const float threshold)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        std::vector<size_t> bounds{ 0 };
+        bounds.insert(bounds.end(), hardBoundaries.begin(), hardBoundaries.end());
+        bounds.push_back(triangleCount);
+
+        FifoCache cache(vertexCount, cacheSize);
+        auto misses = [&](const size_t t)
+        {
+            return int(cache.access(indices[t * 3])) + int(cache.access(indices[t * 3 + 1])) + int(cache.access(indices[t * 3 + 2]));
+        };
+
+        std::vector<size_t> result;
+        for (size_t c = 0; c + 1 < bounds.size(); ++c) {
+            const size_t begin = bounds[c], end = bounds[c + 1];
+            if (begin == end) continue;
+            result.push_back(begin);
+
+            cache.flush();
+            size_t clusterMisses = 0;
+            for (size_t t = begin; t < end; ++t) clusterMisses += misses(t);
+            const double limit = threshold * double(clusterMisses) / double(end - begin);
+
+            cache.flush();
+            size_t pieceStart = begin, pieceMisses = 0;
+            for (size_t t = begin; t + 1 < end; ++t) {
+                pieceMisses += misses(t);
+                if (double(pieceMisses) / double(t + 1 - pieceStart) <= limit) {
+                    result.push_back(t + 1);
+                    pieceStart = t + 1;
+                    pieceMisses = 0;
+                    cache.flush();
+                }
+            }
+        }
+        return result;
+    }
+
+    // Ordena os clusters para que os mais afastados ao longo da própria normal, que tendem a esconder o resto, venham primeiro
+    std::vector<unsigned int> SortClustersForOverdraw(const std::vector<unsigned int>& indices, const std::vector<float>& vertices,
+        const std::vector<size_t>& clusters)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        const size_t clusterCount = clusters.size();
+        std::vector<glm::dvec3> centroid(clusterCount, glm::dvec3(0.0)), normal(clusterCount, glm::dvec3(0.0));
+        std::vector<double> area(clusterCount, 0.0);
+        glm::dvec3 meshCentroid(0.0);
+        double meshArea = 0.0;
+
+        auto position = [&](const unsigned int v)
+        {
+            return glm::dvec3(vertices[v * 8], vertices[v * 8 + 1], vertices[v * 8 + 2]);
+        };
+        for (size_t c = 0; c < clusterCount; ++c) {
+            const size_t end = c + 1 < clusterCount ? clusters[c + 1] : triangleCount;
+            for (size_t t = clusters[c]; t < end; ++t) {
+                const glm::dvec3 a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), d = position(indices[t * 3 + 2]);
+                const glm::dvec3 n = glm::cross(b - a, d - a);
+                const double w = glm::length(n);
+                centroid[c] += w * (a + b + d) / 3.0;
+                normal[c] += n;
+                area[c] += w;
+            }
+            meshCentroid += centroid[c];
+            meshArea += area[c];
+            if (area[c] > 0.0) centroid[c] /= area[c];
+        }
+        if (meshArea > 0.0) meshCentroid /= meshArea;
+
+        std::vector<double> key(clusterCount);
+        for (size_t c = 0; c < clusterCount; ++c) {
+            const double length = glm::length(normal[c]);
+            key[c] = length > 0.0 ? glm::dot(centroid[c] - meshCentroid, normal[c] / length) : 0.0;
+        }
+        std::vector<unsigned int> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b) { return key[a] > key[b]; });
+        return order;
+    }
+}
+
+MeshOptimization::CacheStats MeshOptimization::AnalyzeVertexCache(const unsigned int* indices, const size_t indexCount, const size_t vertexCount,
+    const unsigned int cacheSize)
+{
+    CacheStats stats;
+    if (indexCount < 3) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<char> used(vertexCount, 0);
+    size_t misses = 0, usedCount = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        misses += cache.access(indices[i]);
+        usedCount += !used[indices[i]];
+        used[indices[i]] = 1;
+    }
+    stats.acmr = float(misses) / float(indexCount / 3);
+    stats.atvr = float(misses) / float(usedCount);
+    return stats;
+}
+
+void MeshOptimization::OptimizeMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, const Settings& settings)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const size_t vertexCount = vertices.size() / 8;
+    const size_t triangleCount = indices.size() / 3;
+    const unsigned int cacheSize = std::max(settings.cacheSize, 3u);
+    Stats stats;
+    stats.before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, cacheSize);
+
+    if (triangleCount > 0) {
+        // 1) Ordem para o cache de vértices
+        std::vector<size_t> hardBoundaries;
+        const std::vector<unsigned int> tipsify = Tipsify(indices, vertexCount, cacheSize, hardBoundaries);
+        std::vector<unsigned int> reordered(indices.size());
+        for (size_t t = 0; t < triangleCount; ++t)
+            std::copy_n(indices.begin() + tipsify[t] * 3, 3, reordered.begin() + t * 3);
+        indices.swap(reordered);
+
+        // 2) Overdraw: clusters dessa ordem, os mais externos primeiro
+        if (settings.overdrawThreshold > 0.0f) {
+            const std::vector<size_t> clusters = SoftBoundaries(indices, vertexCount, cacheSize, hardBoundaries, settings.overdrawThreshold);
+            const std::vector<unsigned int> clusterOrder = SortClustersForOverdraw(indices, vertices, clusters);
+            size_t out = 0;
+            for (const unsigned int c : clusterOrder) {
+                const size_t begin = clusters[c] * 3;
+                const size_t end = (c + 1 < clusters.size() ? clusters[c + 1] : triangleCount) * 3;
+                std::copy(indices.begin() + begin, indices.begin() + end, reordered.begin() + out);
+                out += end - begin;
+            }
+            indices.swap(reordered);
+            stats.clusters = clusters.size();
+        }
+
+        // 3) Ordem de leitura dos vértices: o primeiro uso no buffer de índices
+        std::vector<unsigned int> remap(vertexCount, NO_VERTEX);
+        unsigned int next = 0;
+        for (unsigned int& v : indices) {
+            if (remap[v] == NO_VERTEX) remap[v] = next++;
+            v = remap[v];
+        }
+        std::vector<float> fetchOrder(size_t(next) * 8);
+        for (size_t v = 0; v < vertexCount; ++v)
+            if (remap[v] != NO_VERTEX) std::copy_n(vertices.begin() + v * 8, 8, fetchOrder.begin() + size_t(remap[v]) * 8);
+        vertices.swap(fetchOrder);
+    }
+
+    if (settings.stats) {
+        stats.after = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size() / 8, cacheSize);
+        stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        *settings.stats = stats;
+    }
+}
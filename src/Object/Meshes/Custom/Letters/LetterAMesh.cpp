@@ -1,33 +1,45 @@
 #include "Object/Meshes/Custom/Letters/LetterAMesh.h"
 
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterAMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-1.f, -1.25f, -0.3f);
-    const glm::vec3 maxCorner( 1.f,  1.25f,  0.3f);
-    constexpr int resolution =  196;
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterAWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-1.f, -1.25f, -0.3f);
+    const glm::vec3 MAX_CORNER( 1.f,  1.25f,  0.3f);
+    constexpr int RESOLUTION = 196;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.3f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 5;
 
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em X e em Z: só um quarto é amostrado
+        shape.symmetry = glm::bvec3(true, false, true);
+        // O prisma truncado do A estica a distância em até ~4%
+        shape.lipschitz = 1.1f;
+        return shape;
+    }
 }
 
-float LetterAMesh::LetterAWithSDF(const glm::vec3& p)
+LetterAMesh::LetterAMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterAMesh::LetterAWithSDF(const TVec3& p)
 {
     constexpr float height = 1.2f;
-    const float body = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f, 0.0f), {0.5f, 0.3f}, {0.2f, 0.3f}, height);
+    const auto body = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f, 0.0f), {0.5f, 0.3f}, {0.2f, 0.3f}, height);
 
-    const float lowerCut = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f, 0.0f), {0.25f, 0.3f}, {0.15f, 0.3f}, 0.35f);
-    const float upperCut = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f - 0.525f, 0.0f), {0.125f, 0.3f}, {0.05f, 0.3f}, 0.45f);
+    const auto lowerCut = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f, 0.0f), {0.25f, 0.3f}, {0.15f, 0.3f}, 0.35f);
+    const auto upperCut = truncatedPrismSDF(p + glm::vec3(0.0f, height * 0.5f - 0.525f, 0.0f), {0.125f, 0.3f}, {0.05f, 0.3f}, 0.45f);
     
     return opSubtract(opSubtract(body, lowerCut), upperCut);
 }
+
+MeshRefiner::BuildFunction LetterAMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterAWithSDF(p); });
+}
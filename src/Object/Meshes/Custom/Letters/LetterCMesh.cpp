@@ -1,45 +1,55 @@
 #include "Object/Meshes/Custom/Letters/LetterCMesh.h"
 
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterCMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-0.7f, -0.7f, -0.3f);
-    const glm::vec3 maxCorner( 0.7f,  0.7f,  0.3f);
-    constexpr int resolution =  196;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterCWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
-
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-0.7f, -0.7f, -0.3f);
+    const glm::vec3 MAX_CORNER( 0.7f,  0.7f,  0.3f);
+    constexpr int RESOLUTION = 196;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.2f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 5;
+
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em Y e em Z: só um quarto é amostrado
+        shape.symmetry = glm::bvec3(false, true, true);
+        return shape;
+    }
 }
 
-float LetterCMesh::LetterCWithSDF(const glm::vec3& p)
+LetterCMesh::LetterCMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterCMesh::LetterCWithSDF(const TVec3& p)
 {
     // 1) Cilindro maior e interno
-    float outer = cylinderSDF(p, {0,0,-0.3f}, {0,0, 0.3f}, 0.65f);
-    float inner = cylinderSDF(p, {0,0,-0.3f}, {0,0, 0.3f}, 0.45f);
-    float ring  = opSubtract(outer, inner);
+    const auto outer = cylinderSDF(p, {0,0,-0.3f}, {0,0, 0.3f}, 0.65f);
+    const auto inner = cylinderSDF(p, {0,0,-0.3f}, {0,0, 0.3f}, 0.45f);
+    const auto ring = opSubtract(outer, inner);
 
     // 2) Plano de corte vertical (X = cutX) — mantém p.x ≤ cutX
     constexpr float cutX =  0.3f;  
-    const float planeX   = planeSDF(p, {1,0,0}, cutX);
+    const auto planeX = planeSDF(p, {1,0,0}, cutX);
 
     // 3) Plano de corte horizontal (Y = cutY) — mantém p.y ≥ cutY
     //    se preferir cortar em p.y ≤ cutY, basta inverter o offset:
     constexpr float cutZ = 0.2f;
-    const float planeZ   = planeSDF(p, {0,0,1}, cutZ);
-    const float planeNZ = planeSDF(p, {0,0,-1}, cutZ);
+    const auto planeZ = planeSDF(p, {0,0,1}, cutZ);
+    const auto planeNZ = planeSDF(p, {0,0,-1}, cutZ);
 
     // 4) Interseções em cadeia: ring ∩ X‐meio‐espaço ∩ Y‐meio‐espaço
-    const float cutAlongX = opIntersection(ring, planeX);
-    const float cutAlongZ = opIntersection(cutAlongX, planeZ);
+    const auto cutAlongX = opIntersection(ring, planeX);
+    const auto cutAlongZ = opIntersection(cutAlongX, planeZ);
     return opIntersection(cutAlongZ, planeNZ);
 }
+
+MeshRefiner::BuildFunction LetterCMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterCWithSDF(p); });
+}
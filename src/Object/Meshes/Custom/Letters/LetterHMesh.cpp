@@ -1,33 +1,43 @@
 #include "Object/Meshes/Custom/Letters/LetterHMesh.h"
 
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterHMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-0.5f, -0.625f, -0.3f);
-    const glm::vec3 maxCorner( 0.5f,  0.625f,  0.3f);
-    constexpr int resolution =  64;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterHWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-0.5f, -0.625f, -0.3f);
+    const glm::vec3 MAX_CORNER( 0.5f,  0.625f,  0.3f);
+    constexpr int RESOLUTION = 48;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.1f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 5;
 
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em X, em Y e em Z: só um oitavo é amostrado
+        shape.symmetry = glm::bvec3(true, true, true);
+        return shape;
+    }
 }
 
-float LetterHMesh::LetterHWithSDF(const glm::vec3& p)
+LetterHMesh::LetterHMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterHMesh::LetterHWithSDF(const TVec3& p)
 {
-    const float base = boxSDF(p, glm::vec3(0.5f, 0.625f, 0.1f));
+    const auto base = boxSDF(p, glm::vec3(0.5f, 0.625f, 0.1f));
 
-    const float cut1 = boxSDF(p - glm::vec3(0.0f, +0.3625f, 0.0f), glm::vec3(0.3f,  0.2625f,  0.1f));
-    const float cut2 = boxSDF(p - glm::vec3(0.0f, -0.3625f, 0.0f), glm::vec3(0.3f,  0.2625f,  0.1f));  
+    const auto cut1 = boxSDF(p - glm::vec3(0.0f, +0.3625f, 0.0f), glm::vec3(0.3f,  0.2625f,  0.1f));
+    const auto cut2 = boxSDF(p - glm::vec3(0.0f, -0.3625f, 0.0f), glm::vec3(0.3f,  0.2625f,  0.1f));  
 
-    const float h = opSubtract(opSubtract(base, cut1), cut2);
+    const auto h = opSubtract(opSubtract(base, cut1), cut2);
     return h;
 }
+
+MeshRefiner::BuildFunction LetterHMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterHWithSDF(p); });
+}
@@ -1,40 +1,47 @@
 #include "Object/Meshes/Custom/Letters/LetterNMesh.h"
 
-#include <glm/ext/matrix_transform.hpp>
-
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterNMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-1.f, -1.f, -0.3f);
-    const glm::vec3 maxCorner( 1.f,  1.f,  0.3f);
-    constexpr int resolution = 128;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterNWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-1.f, -1.f, -0.3f);
+    const glm::vec3 MAX_CORNER( 1.f,  1.f,  0.3f);
+    constexpr int RESOLUTION = 128;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.1f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 4;
 
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em Z (plano z = 0): só metade é amostrada
+        shape.symmetry = glm::bvec3(false, false, true);
+        return shape;
+    }
 }
 
-float LetterNMesh::LetterNWithSDF(const glm::vec3& p)
+LetterNMesh::LetterNMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterNMesh::LetterNWithSDF(const TVec3& p)
 {
-    const glm::mat4 CW_Rot = glm::rotate(glm::mat4(1.0f),glm::radians(90.0f),glm::vec3(0,0,1));
-    const glm::mat4 CCW_Rot = glm::rotate(glm::mat4(1.0f),glm::radians(-90.0f),glm::vec3(0,0,1));
-    const glm::vec3 CW_p = glm::vec3(CW_Rot * glm::vec4(p - glm::vec3(0.05f, 0.2f, 0.0f),1.0f));
-    const glm::vec3 CCW_p = glm::vec3(CCW_Rot * glm::vec4(p + glm::vec3(0.05f, 0.2f, 0.0f),1.0f));
+    // Rotações de ±90° em torno de Z (sem montar matrizes a cada amostra)
+    const auto CW_p = rotateZ(p - glm::vec3(0.05f, 0.2f, 0.0f), 90.0f);
+    const auto CCW_p = rotateZ(p + glm::vec3(0.05f, 0.2f, 0.0f), -90.0f);
     
     constexpr float height = 1.2f;
-    const float body = boxSDF(p, glm::vec3(0.5f, height*0.5f, 0.1f));
+    const auto body = boxSDF(p, glm::vec3(0.5f, height*0.5f, 0.1f));
 
-    const float cut1 = wedgeSDF(CCW_p, 0.45f, 0.3f, 0.2f);
-    const float cut2 = wedgeSDF(CW_p, 0.45f, 0.3f, 0.2f);
+    const auto cut1 = wedgeSDF(CCW_p, 0.45f, 0.3f, 0.2f);
+    const auto cut2 = wedgeSDF(CW_p, 0.45f, 0.3f, 0.2f);
     
     return opSubtract(opSubtract(body, cut1), cut2);
 }
+
+MeshRefiner::BuildFunction LetterNMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterNWithSDF(p); });
+}
@@ -1,40 +1,52 @@
 #include "Object/Meshes/Custom/Letters/LetterOMesh.h"
 
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterOMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-1.f, -1.f, -0.3f);
-    const glm::vec3 maxCorner( 1.f,  1.f,  0.3f);
-    constexpr int resolution =  150;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterOWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-1.f, -1.f, -0.3f);
+    const glm::vec3 MAX_CORNER( 1.f,  1.f,  0.3f);
+    constexpr int RESOLUTION = 150;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.15f;  // meia espessura em Z: o depth 0.3 dos cilindros elípticos é a espessura inteira
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 5;
 
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em X, em Y e em Z: só um oitavo é amostrado
+        shape.symmetry = glm::bvec3(true, true, true);
+        // Os cilindros elípticos não são SDFs exatos: |∇| chega a 1/0.3 no anel interno
+        shape.lipschitz = 3.4f;
+        return shape;
+    }
 }
 
-float LetterOMesh::LetterOWithSDF(const glm::vec3& p)
+LetterOMesh::LetterOMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterOMesh::LetterOWithSDF(const TVec3& p)
 {
     // 1) Cilindro maior e interno
-    float outer = cappedEllipticalCylinderSDF(p, 0.5f, 0.625f, 0.3f);
-    float inner = cappedEllipticalCylinderSDF(p, 0.3f, 0.375, 0.3f);
-    float ring  = opSubtract(outer, inner);
+    const auto outer = cappedEllipticalCylinderSDF(p, 0.5f, 0.625f, 0.3f);
+    const auto inner = cappedEllipticalCylinderSDF(p, 0.3f, 0.375, 0.3f);
+    const auto ring = opSubtract(outer, inner);
 
     // 2) Plano de corte horizontal (Y = cutY) — mantém p.y ≥ cutY
     //    se preferir cortar em p.y ≤ cutY, basta inverter o offset:
     constexpr float cutZ = 0.2f;
-    const float planeZ   = planeSDF(p, {0,0,1}, cutZ);
-    const float planeNZ = planeSDF(p, {0,0,-1}, cutZ);
+    const auto planeZ = planeSDF(p, {0,0,1}, cutZ);
+    const auto planeNZ = planeSDF(p, {0,0,-1}, cutZ);
 
     // 3) Interseções em cadeia: ring ∩ X‐meio‐espaço ∩ Y‐meio‐espaço
-    const float cutAlongZ = opIntersection(ring, planeZ);
+    const auto cutAlongZ = opIntersection(ring, planeZ);
     return opIntersection(cutAlongZ, planeNZ);
 }
+
+MeshRefiner::BuildFunction LetterOMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterOWithSDF(p); });
+}
@@ -2,28 +2,33 @@
 
 #include <glm/ext/matrix_transform.hpp>
 
-#include "MarchingCubes/Polygonizer.h"
-
-void LetterSMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-1.f, -1.f, -0.3f);
-    const glm::vec3 maxCorner( 1.f,  1.f,  0.3f);
-    constexpr int resolution = 196;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return LetterSWithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
-
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-1.f, -1.f, -0.3f);
+    const glm::vec3 MAX_CORNER( 1.f,  1.f,  0.3f);
+    constexpr int RESOLUTION = 196;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.2f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 4;
+
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em Z (plano z = 0): só metade é amostrada
+        shape.symmetry = glm::bvec3(false, false, true);
+        return shape;
+    }
 }
 
-float LetterSMesh::LetterSWithSDF(const glm::vec3& p)
+LetterSMesh::LetterSMesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto LetterSMesh::LetterSWithSDF(const TVec3& p)
 {
     const float H        = 1.2f;
     const float halfH    = 0.2f;
@@ -41,19 +46,24 @@ float LetterSMesh::LetterSWithSDF(const glm::vec3& p)
     glm::vec3 offsetBox{0.225f, 0.0f, 0.0f};
     
     // cilindro inferior (deitado, circular no plano XY, z ∈ [–0.6,0])
-    float cylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R);
-    float minorCylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R*0.5f);
-    float boxBottom = boxSDF(p + offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
-    float sBottom = opSubtract( opSubtract(cylBottom, minorCylBottom), boxBottom);
+    const auto cylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R);
+    const auto minorCylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R*0.5f);
+    const auto boxBottom = boxSDF(p + offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
+    const auto sBottom = opSubtract( opSubtract(cylBottom, minorCylBottom), boxBottom);
 
     // cilindro superior (z ∈ [0,+0.6])
-    float cylTop    = cappedCylinderSDF(p - offset, A_top, B_top, R);
-    float minorCylTop = cappedCylinderSDF(p - offset, A_bot, B_bot, R*0.5f);
-    float boxTop = boxSDF(p - offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
-    float sTop = opSubtract( opSubtract(cylTop, minorCylTop), boxTop);
+    const auto cylTop = cappedCylinderSDF(p - offset, A_top, B_top, R);
+    const auto minorCylTop = cappedCylinderSDF(p - offset, A_bot, B_bot, R*0.5f);
+    const auto boxTop = boxSDF(p - offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
+    const auto sTop = opSubtract( opSubtract(cylTop, minorCylTop), boxTop);
 
     glm::vec3 connHalf{ 0.05f, R * 0.25f, halfH};
-    float connector = boxSDF(p, connHalf);
+    const auto connector = boxSDF(p, connHalf);
 
     return opUnion(opUnion(sBottom, sTop), connector);
 }
+
+MeshRefiner::BuildFunction LetterSMesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return LetterSWithSDF(p); });
+}
@@ -1,28 +1,37 @@
 #include "Object/Meshes/Custom/Numbers/Number2Mesh.h"
 
-#include "MarchingCubes/Polygonizer.h"
+#include "Object/Meshes/GlyphMesher.h"
+#include "Object/Meshes/MeshCache.h"
+#include "Object/Meshes/MeshQuality.h"
 #include "Object/Meshes/Custom/Letters/LetterSMesh.h"
 
-void Number2Mesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+namespace
 {
-    // Define o volume de amostragem
-    const glm::vec3 minCorner(-1.f, -1.f, -0.3f);
-    const glm::vec3 maxCorner( 1.f,  1.f,  0.3f);
-    constexpr int resolution = 196;  // aumenta para mais detalhe
-    
-    // Chama o marching cubes
-    Polygonizer::PolygonizeSurface(
-        [this](const glm::vec3& p) { return Number2WithSDF(p); },
-        minCorner, maxCorner,
-        resolution,
-        vertices, indices,
-        false
-    );
+    // Volume de amostragem e resolução; também entram na chave do cache de malhas
+    const glm::vec3 MIN_CORNER(-1.f, -1.f, -0.3f);
+    const glm::vec3 MAX_CORNER( 1.f,  1.f,  0.3f);
+    constexpr int RESOLUTION = 196;  // células no eixo mais longo; aumenta para mais detalhe
+    constexpr float HALF_DEPTH = 0.2f;  // meia espessura em Z, a mesma do SDF
+    // Suba ao mudar o SDF ou o volume, para o cache não devolver a malha antiga
+    constexpr int MESH_VERSION = 4;
 
-    RecalculateUVs(minCorner, maxCorner, vertices);
+    GlyphMesher::Shape MakeShape()
+    {
+        GlyphMesher::Shape shape;
+        shape.minCorner = MIN_CORNER;
+        shape.maxCorner = MAX_CORNER;
+        shape.resolution = RESOLUTION;
+        shape.halfDepth = HALF_DEPTH;
+        // O glifo é simétrico em Z (plano z = 0): só metade é amostrada
+        shape.symmetry = glm::bvec3(false, false, true);
+        return shape;
+    }
 }
 
-float Number2Mesh::Number2WithSDF(const glm::vec3& p)
+Number2Mesh::Number2Mesh() : GlyphMesh(MakeShape(), MESH_VERSION) {}
+
+template<typename TVec3>
+auto Number2Mesh::Number2WithSDF(const TVec3& p)
 {
     const float H        = 1.2f;
     const float halfH    = 0.2f;
@@ -40,26 +49,31 @@ float Number2Mesh::Number2WithSDF(const glm::vec3& p)
     glm::vec3 offsetBox{0.225f, 0.0f, 0.0f};
     
     // cilindro inferior (deitado, circular no plano XY, z ∈ [–0.6,0])
-    float cylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R);
-    float minorCylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R*0.5f);
-    float boxBottom = boxSDF(p + offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
-    float sBottom = opSubtract( opSubtract(cylBottom, minorCylBottom), boxBottom);
+    const auto cylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R);
+    const auto minorCylBottom = cappedCylinderSDF(p + offset, A_bot, B_bot, R*0.5f);
+    const auto boxBottom = boxSDF(p + offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
+    const auto sBottom = opSubtract( opSubtract(cylBottom, minorCylBottom), boxBottom);
 
     // cilindro superior (z ∈ [0,+0.6])
-    float cylTop    = cappedCylinderSDF(p - offset, A_top, B_top, R);
-    float minorCylTop = cappedCylinderSDF(p - offset, A_bot, B_bot, R*0.5f);
-    float boxTop = boxSDF(p - offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
-    float sTop = opSubtract( opSubtract(cylTop, minorCylTop), boxTop);
+    const auto cylTop = cappedCylinderSDF(p - offset, A_top, B_top, R);
+    const auto minorCylTop = cappedCylinderSDF(p - offset, A_bot, B_bot, R*0.5f);
+    const auto boxTop = boxSDF(p - offsetBox, glm::vec3(0.225f, 0.225f, 0.3f));
+    const auto sTop = opSubtract( opSubtract(cylTop, minorCylTop), boxTop);
 
     glm::vec3 connHalf{ 0.05f, R * 0.25f, halfH};
-    float connector = boxSDF(p, connHalf);
+    const auto connector = boxSDF(p, connHalf);
 
-    float S = opUnion(opUnion(sBottom, sTop), connector);
+    const auto S = opUnion(opUnion(sBottom, sTop), connector);
     
     const glm::vec3 offset2Box{0, 0.57f, 0.0f};
     
-    const float removeBox = boxSDF(p + offset2Box, glm::vec3(1.0f, 0.225f, 0.2f));
-    const float addBox = boxSDF(p + offset2Box - glm::vec3(0.0f, 0.125f, 0.0f), glm::vec3(0.45f, 0.225f * 0.5f, 0.2f));
+    const auto removeBox = boxSDF(p + offset2Box, glm::vec3(1.0f, 0.225f, 0.2f));
+    const auto addBox = boxSDF(p + offset2Box - glm::vec3(0.0f, 0.125f, 0.0f), glm::vec3(0.45f, 0.225f * 0.5f, 0.2f));
 
     return opUnion(opSubtract(S, removeBox), addBox);
 }
+
+MeshRefiner::BuildFunction Number2Mesh::levelBuilder() const
+{
+    return MakeBuilder([](const auto& p) { return Number2WithSDF(p); });
+}
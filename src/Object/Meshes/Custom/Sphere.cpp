@@ -2,11 +2,18 @@
 
 #include <vector>
 
+#include "Object/Meshes/MeshCache.h"
 #include "Utility/Constants/MathConsts.h"
 
 Sphere::Sphere(const unsigned int sectorCount, const unsigned int stackCount, const float radius)
     : m_SectorCount(sectorCount), m_StackCount(stackCount), m_Radius(radius){}
 
+bool Sphere::describeCacheKey(MeshCache::Key& key) const
+{
+    key.add(m_SectorCount).add(m_StackCount).add(m_Radius);
+    return true;
+}
+
 void Sphere::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
 {
     for (unsigned int i = 0; i <= m_StackCount; ++i)
@@ -0,0 +1,16 @@
+#include "Object/Meshes/GlyphMesh.h"
+
+#include "Object/Meshes/MeshCache.h"
+
+void GlyphMesh::setupMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices)
+{
+    levelBuilder()(MeshLevel{}, vertices, indices);
+}
+
+bool GlyphMesh::describeCacheKey(MeshCache::Key& key) const
+{
+    key.add(m_Shape.minCorner).add(m_Shape.maxCorner).add(m_Shape.resolution).add(m_Shape.halfDepth).add(m_MeshVersion);
+    MeshQuality::AddToKey(key);
+    GlyphMesher::AddToKey(key);
+    return true;
+}
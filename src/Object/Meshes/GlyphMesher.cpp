@@ -0,0 +1,23 @@
+#include "Object/Meshes/GlyphMesher.h"
+
+#include <cstring>
+
+GlyphMesher::Settings& GlyphMesher::GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+bool GlyphMesher::Parse(const char* name, Method& out)
+{
+    if (std::strcmp(name, "extrusion") == 0) out = Method::Extrusion;
+    else if (std::strcmp(name, "marching-cubes") == 0) out = Method::MarchingCubes;
+    else if (std::strcmp(name, "dual-contouring") == 0) out = Method::DualContouring;
+    else return false;
+    return true;
+}
+
+void GlyphMesher::AddToKey(MeshCache::Key& key)
+{
+    key.add(static_cast<int>(GetSettings().method));
+}
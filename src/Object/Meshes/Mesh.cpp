@@ -1,137 +1,172 @@
 #include "Object/Meshes/Mesh.h"
 
-#include <glm/gtc/type_ptr.hpp>
+#include <iomanip>
+#include <iostream>
+#include <typeinfo>
 
-#include "Light.h"
-#include "Utility/Constants/EngineLimits.h"
+#include "MeshOptimization/MeshOptimization.h"
+#include "Object/Meshes/MeshCache.h"
+#include "Object/Meshes/MeshRefiner.h"
+#include "Object/Meshes/MeshRegistry.h"
 
-Mesh::Mesh()
-    : m_Material{Material()}, locModel(0), locView(0), locProjection(0), locViewPosition(0), locMaterialShininess(0), locMaterialDiffuse{0} {}
+namespace
+{
+    // Ordem de triângulos e vértices para os caches da GPU. Roda antes do MeshCache::Store, então um acerto no cache já vem otimizado
+    void OptimizeForGpu(std::vector<float>& vertices, std::vector<unsigned int>& indices, const char* label)
+    {
+        MeshOptimization::Stats stats;
+        MeshOptimization::Settings settings;
+        settings.stats = &stats;
+        MeshOptimization::OptimizeMesh(vertices, indices, settings);
+
+        if (VertexFormat::GetSettings().report)
+        {
+            std::cout << "Malha " << label << ": ACMR " << std::fixed << std::setprecision(3) << stats.before.acmr << " -> "
+                      << stats.after.acmr << ", ATVR " << stats.before.atvr << " -> " << stats.after.atvr << " (cache de "
+                      << settings.cacheSize << " vértices, " << stats.clusters << " blocos para o overdraw)" << std::defaultfloat << std::endl;
+        }
+    }
+}
 
-Mesh::~Mesh()
+Mesh::Mesh()
+    : m_Material{Material()}, m_VertexLayout(VertexFormat::GetSettings().defaultLayout)
 {
-    if (m_ebo) glDeleteBuffers(1, &m_ebo);
-    if (m_vbo) glDeleteBuffers(1, &m_vbo);
-    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    cacheUniformLocations();
 }
 
+Mesh::~Mesh() = default;
+
 bool Mesh::initialize()
 {
-    m_Material.shader.use();
+    // Os uniforms do material (sampler, brilho, cor) são definidos pelo Material::bind em todo desenho
+    MeshCache::Key key(typeid(*this).name());
+    const bool keyed = describeCacheKey(key);
 
-    cacheUniformLocations();
-    if (locMaterialDiffuse >= 0) glUniform1i(locMaterialDiffuse, 0);
-    if (locMaterialShininess >= 0) glUniform1f(locMaterialShininess, 64.0f);
-    
-    glActiveTexture(GL_TEXTURE0);
-    m_Material.diffuseMap.bind();
+    // Os buffers da GPU também dependem do formato de vértice; o cache em disco não (ele guarda o layout em floats)
+    MeshCache::Key buffersKey = key;
+    buffersKey.add(static_cast<int>(m_VertexLayout));
 
-    std::vector<float> vertexes;
-    std::vector<unsigned int> indexes;
-    setupMesh(vertexes, indexes);
+    // Outra malha viva com a mesma chave já enviou esta geometria
+    if (keyed && (m_Buffers = MeshRegistry::Find(buffersKey.hash()))) return true;
 
-    // Upload to GPU
-    setupBuffers(vertexes, indexes);
+    // Acerto no cache em disco: o arquivo mapeado vai direto para a GPU, sem poligonização
+    MeshCache::MappedMesh cached;
+    if (keyed && MeshCache::Load(key, cached))
+    {
+        setupBuffers(cached.vertices(), cached.vertexFloatCount(), cached.indices(), cached.indexCount());
+    }
+    // Malhas de SDF: prévia grosseira agora, resolução completa em segundo plano
+    else if (!setupPreview(keyed ? &key : nullptr))
+    {
+        std::vector<float> vertexes;
+        std::vector<unsigned int> indexes;
+        setupMesh(vertexes, indexes);
+        OptimizeForGpu(vertexes, indexes, typeid(*this).name());
+        if (keyed) MeshCache::Store(key, vertexes, indexes);
+
+        // Envia para a GPU
+        setupBuffers(vertexes, indexes);
+    }
+
+    if (keyed) MeshRegistry::Add(buffersKey.hash(), m_Buffers);
     
     return true;
 }
 
-void Mesh::render(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::mat4& modelMatrix, const std::vector<Light>& lights, const glm::vec3& cameraPosition)
+bool Mesh::setupPreview(const MeshCache::Key* key)
 {
-    m_Material.bind();
+    const MeshRefiner::Settings& settings = MeshRefiner::GetSettings();
+    if (!settings.enabled) return false;
 
-    // Send matrices
-    glUniformMatrix4fv(locModel, 1, GL_FALSE, value_ptr(modelMatrix));
-    glUniformMatrix4fv(locView,  1, GL_FALSE, glm::value_ptr(viewMatrix));
-    glUniformMatrix4fv(locProjection,  1, GL_FALSE, glm::value_ptr(projectionMatrix));
+    const MeshRefiner::BuildFunction build = levelBuilder();
+    if (!build) return false;
 
-    // Camera Position
-    glUniform3fv(locViewPosition, 1, glm::value_ptr(cameraPosition));
+    MeshLevel preview;
+    preview.resolution = settings.previewResolution;
 
-    // Bind diffuse texture to unit 0
-    //glActiveTexture(GL_TEXTURE0);
-    //m_Material.diffuseMap.bind();
+    // A prévia também vai para o cache, com chave própria, para uma execução fechada cedo ainda abrir rápido na próxima
+    MeshCache::Key previewKey = key ? *key : MeshCache::Key("");
+    previewKey.add("preview").add(preview.resolution);
 
-    // Send Lights
-    for (size_t i = 0; i < lights.size(); i++)
+    MeshCache::MappedMesh cached;
+    if (key && MeshCache::Load(previewKey, cached))
     {
-        const Light& light = lights[i];
-        glUniform3fv(locLightPosition[i],   1, glm::value_ptr(light.position));
-        glUniform3fv(locLightColor[i], 1, glm::value_ptr(light.color));
-        glUniform1f (locLightConst[i], light.constant);
-        glUniform1f (locLightLinear[i],   light.linear);
-        glUniform1f (locLightQuad[i],  light.quadratic);
+        setupBuffers(cached.vertices(), cached.vertexFloatCount(), cached.indices(), cached.indexCount());
+    }
+    else
+    {
+        std::vector<float> vertexes;
+        std::vector<unsigned int> indexes;
+        if (!build(preview, vertexes, indexes)) return false;
+        OptimizeForGpu(vertexes, indexes, typeid(*this).name());
+        if (key) MeshCache::Store(previewKey, vertexes, indexes);
+        setupBuffers(vertexes, indexes);
     }
 
-    // Draw
-    glBindVertexArray(m_vao);
-    glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
-
-    //m_Material.diffuseMap.unbind();
+    // A tarefa pode sobreviver a esta malha: recebe o construtor e o rótulo por valor, nunca `this`
+    // Pertence aos buffers, não a esta malha: continua enquanto alguma malha os desenha e é cancelada junto com eles
+    m_Buffers->refinement = MeshRefiner::Submit(
+        [build, label = typeid(*this).name()](const MeshLevel& level, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+        {
+            if (!build(level, vertices, indices)) return false;
+            OptimizeForGpu(vertices, indices, label);
+            return true;
+        },
+        m_Buffers, key);
+    return true;
 }
 
-void Mesh::setupBuffers(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+void Mesh::render(const glm::mat4& modelMatrix)
 {
-    m_indexCount = static_cast<unsigned int>(indices.size());
+    // Nunca inicializada (p. ex. a malha invisível da câmera): nada a desenhar
+    if (!m_Buffers) return;
 
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-    glGenBuffers(1, &m_ebo);
+    m_Material.bind();
 
-    glBindVertexArray(m_vao);
+    // Envia a matriz de modelo; view, projection, posição da câmera e luzes ficam nos uniform buffers do frame
+    const Shader& shader = m_Material.shader;
+    shader.set(uModel, modelMatrix);
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    // Formato de vértice: o shader devolve as posições e normais compactadas ao espaço do modelo
+    shader.set(uPositionOffset, m_Buffers->dequantization.offset);
+    shader.set(uPositionScale, m_Buffers->dequantization.scale);
+    shader.set(uOctNormal, m_Buffers->layout == VertexFormat::Layout::Packed);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
+    // Bind diffuse texture to unit 0
+    //glActiveTexture(GL_TEXTURE0);
+    //m_Material.diffuseMap.bind();
 
-    // Layout: Position (3 Floats), Normal (3 Floats), Texture Coord (2 Floats).
-    constexpr GLsizei stride = 8 * sizeof(float);
+    // Desenha. O VAO continua ligado: o próximo desenho da mesma geometria (a RenderQueue os mantém juntos) pula o bind
+    MeshRegistry::BindVertexArray(m_Buffers->vao);
+    glDrawElements(GL_TRIANGLES, m_Buffers->indexCount, m_Buffers->shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, nullptr);
 
-    // Posição - Layout 0
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, static_cast<void*>(nullptr));
-    glEnableVertexAttribArray(0);
+    //m_Material.diffuseMap.unbind();
+}
 
-    // Normal - Layout 1
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+unsigned int Mesh::getVertexArray() const
+{
+    return m_Buffers ? m_Buffers->vao : 0;
+}
 
-    // Texture Coord - Layout 2
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+void Mesh::setupBuffers(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+{
+    setupBuffers(vertices.data(), vertices.size(), indices.data(), indices.size());
+}
 
-    glBindVertexArray(0);
+void Mesh::setupBuffers(const float* vertices, const size_t vertexFloatCount, const unsigned int* indices, const size_t indexCount)
+{
+    auto buffers = std::make_shared<MeshBuffers>();
+    buffers->layout = m_VertexLayout;
+    buffers->label = typeid(*this).name();
+    buffers->upload(vertices, vertexFloatCount, indices, indexCount);
+    m_Buffers = std::move(buffers);
 }
 
 void Mesh::cacheUniformLocations()
 {
-    locModel = glGetUniformLocation(m_Material.shader.ID, "model");
-    locView = glGetUniformLocation(m_Material.shader.ID, "view");
-    locProjection = glGetUniformLocation(m_Material.shader.ID, "projection");
-    locViewPosition = glGetUniformLocation(m_Material.shader.ID, "viewPos");
-    locMaterialShininess = glGetUniformLocation(m_Material.shader.ID, "material.shininess");
-    locMaterialDiffuse = glGetUniformLocation(m_Material.shader.ID, "material.diffuse");
-
-    locLightPosition.resize(EngineLimits::MAX_LIGHTS);
-    locLightColor.resize(EngineLimits::MAX_LIGHTS);
-    locLightConst.resize(EngineLimits::MAX_LIGHTS);
-    locLightLinear.resize(EngineLimits::MAX_LIGHTS);
-    locLightQuad.resize(EngineLimits::MAX_LIGHTS);
-
-    char buf[64];
-    for (int i = 0; i < EngineLimits::MAX_LIGHTS; i++)
-    {
-        snprintf(buf, sizeof(buf), "lights[%d].position",  i);
-        locLightPosition[i]   = glGetUniformLocation(m_Material.shader.ID, buf);
-        snprintf(buf, sizeof(buf), "lights[%d].color",     i);
-        locLightColor[i] = glGetUniformLocation(m_Material.shader.ID, buf);
-        snprintf(buf, sizeof(buf), "lights[%d].constant",  i);
-        locLightConst[i] = glGetUniformLocation(m_Material.shader.ID, buf);
-        snprintf(buf, sizeof(buf), "lights[%d].linear",    i);
-        locLightLinear[i]   = glGetUniformLocation(m_Material.shader.ID, buf);
-        snprintf(buf, sizeof(buf), "lights[%d].quadratic", i);
-        locLightQuad[i]  = glGetUniformLocation(m_Material.shader.ID, buf);
-    }
+    const Shader& shader = m_Material.shader;
+    uModel = shader.uniform<glm::mat4>("model");
+    uPositionOffset = shader.uniform<glm::vec3>("positionOffset");
+    uPositionScale = shader.uniform<glm::vec3>("positionScale");
+    uOctNormal = shader.uniform<bool>("octNormal");
 }
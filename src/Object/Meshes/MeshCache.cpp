@@ -0,0 +1,352 @@
+#include "Object/Meshes/MeshCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr char MAGIC[4] = { 'C', 'G', 'M', 'C' };
+    // Gravado na ordem de bytes da máquina; um arquivo de uma máquina com a outra endianness é lido como falta
+    constexpr uint32_t ENDIAN_TAG = 0x01020304u;
+    constexpr uint32_t FLOATS_PER_VERTEX = 8;
+    constexpr const char* EXTENSION = ".mesh";
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t endianTag;
+        uint32_t floatsPerVertex;
+        uint64_t keyHash;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint64_t boundsOffset;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t fileSize;
+    };
+
+    struct BoundsBlock
+    {
+        float min[3];
+        float max[3];
+    };
+
+    uint64_t AlignUp(const uint64_t value)
+    {
+        return (value + MeshCache::BLOB_ALIGNMENT - 1) / MeshCache::BLOB_ALIGNMENT * MeshCache::BLOB_ALIGNMENT;
+    }
+
+    fs::path EntryPath(const MeshCache::Key& key)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key.hash()));
+        return fs::path(MeshCache::GetSettings().directory) / (std::string(name) + EXTENSION);
+    }
+
+    bool ValidHeader(const FileHeader& header, const uint64_t keyHash, const uint64_t fileSize)
+    {
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+        if (header.formatVersion != MeshCache::FORMAT_VERSION || header.endianTag != ENDIAN_TAG) return false;
+        if (header.floatsPerVertex != FLOATS_PER_VERTEX || header.keyHash != keyHash) return false;
+        if (header.fileSize != fileSize) return false;
+
+        // Offsets antes das contagens, e as contagens comparadas por divisão: um arquivo danificado com uma contagem
+        // enorme não pode dar a volta no uint64_t e passar pelas verificações
+        if (header.boundsOffset < sizeof(FileHeader) || header.boundsOffset > header.vertexOffset
+            || header.vertexOffset - header.boundsOffset < sizeof(BoundsBlock)
+            || header.vertexOffset > header.indexOffset || header.indexOffset > fileSize) return false;
+        if (header.vertexOffset % MeshCache::BLOB_ALIGNMENT != 0 || header.indexOffset % MeshCache::BLOB_ALIGNMENT != 0)
+            return false;
+
+        return header.vertexCount <= (header.indexOffset - header.vertexOffset) / (FLOATS_PER_VERTEX * sizeof(float))
+            && header.indexCount <= (fileSize - header.indexOffset) / sizeof(unsigned int)
+            && header.indexCount % 3 == 0;
+    }
+
+    // Uma passada pelos índices mapeados: um arquivo do tamanho certo com o conteúdo danificado não pode chegar ao
+    // glDrawElements com índices fora da malha (nem ser truncado calado pelo NarrowIndices)
+    bool ValidIndices(const unsigned int* indices, const uint64_t indexCount, const uint64_t vertexCount)
+    {
+        unsigned int largest = 0;
+        for (uint64_t i = 0; i < indexCount; ++i) largest = std::max(largest, indices[i]);
+        return indexCount == 0 || largest < vertexCount;
+    }
+
+    // As entradas usadas há mais tempo saem primeiro até o diretório caber em maxBytes; `keep` nunca é removida
+    void EnforceSizeCap(const fs::path& keep)
+    {
+        struct Entry { fs::path path; uint64_t size; fs::file_time_type used; };
+        std::vector<Entry> entries;
+        uint64_t total = 0;
+
+        std::error_code ec;
+        for (const auto& item : fs::directory_iterator(MeshCache::GetSettings().directory, ec))
+        {
+            if (!item.is_regular_file(ec) || item.path().extension() != EXTENSION) continue;
+            const uint64_t size = item.file_size(ec);
+            if (ec) continue;
+            entries.push_back({ item.path(), size, item.last_write_time(ec) });
+            total += size;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.used < b.used; });
+        for (const Entry& entry : entries)
+        {
+            if (total <= MeshCache::GetSettings().maxBytes) break;
+            if (entry.path == keep) continue;
+            if (fs::remove(entry.path, ec)) total -= entry.size;
+        }
+    }
+}
+
+MeshCache::Settings& MeshCache::GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+MeshCache::Key::Key(const char* meshClass)
+    : m_Hash(14695981039346656037ull)
+{
+    add(meshClass);
+    add(FORMAT_VERSION);
+    add(MESHER_VERSION);
+}
+
+MeshCache::Key& MeshCache::Key::add(const void* data, const size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        m_Hash ^= bytes[i];
+        m_Hash *= 1099511628211ull;
+    }
+    return *this;
+}
+
+MeshCache::Key& MeshCache::Key::add(const char* text)
+{
+    // O terminador também entra no hash, então "ab" + "c" difere de "a" + "bc"
+    return add(text, std::strlen(text) + 1);
+}
+
+MeshCache::MappedMesh::~MappedMesh()
+{
+    unmap();
+}
+
+void MeshCache::MappedMesh::unmap()
+{
+#ifdef _WIN32
+    if (m_Base) UnmapViewOfFile(m_Base);
+    if (m_MappingHandle) CloseHandle(m_MappingHandle);
+    if (m_FileHandle) CloseHandle(m_FileHandle);
+    m_FileHandle = m_MappingHandle = nullptr;
+#else
+    if (m_Base) munmap(m_Base, m_Size);
+#endif
+    m_Base = nullptr;
+    m_Size = 0;
+    m_Vertices = nullptr;
+    m_Indices = nullptr;
+    m_VertexFloatCount = m_IndexCount = 0;
+}
+
+bool MeshCache::Load(const Key& key, MappedMesh& out)
+{
+    out.unmap();
+    if (!GetSettings().enabled) return false;
+
+    const fs::path path = EntryPath(key);
+    std::error_code ec;
+    if (!fs::exists(path, ec)) return false;
+
+    // A data de modificação também serve de marca do LRU. Atualizada antes do mapeamento: o Windows se recusa a
+    // mudar as datas de um arquivo que mantemos aberto só para leitura
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader)))
+    {
+        CloseHandle(file);
+        fs::remove(path, ec);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    out.m_FileHandle = file;
+    out.m_MappingHandle = mapping;
+    out.m_Base = base;
+    out.m_Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader)))
+    {
+        close(fd);
+        fs::remove(path, ec);
+        return false;
+    }
+    void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // O mapeamento mantém a sua própria referência ao arquivo
+    close(fd);
+    out.m_Base = base == MAP_FAILED ? nullptr : base;
+    out.m_Size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!out.m_Base)
+    {
+        out.unmap();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, out.m_Base, sizeof(header));
+    if (!ValidHeader(header, key.hash(), out.m_Size))
+    {
+        out.unmap();
+        fs::remove(path, ec);
+        return false;
+    }
+
+    const auto* bytes = static_cast<const unsigned char*>(out.m_Base);
+    const auto* indices = reinterpret_cast<const unsigned int*>(bytes + header.indexOffset);
+    if (!ValidIndices(indices, header.indexCount, header.vertexCount))
+    {
+        out.unmap();
+        fs::remove(path, ec);
+        return false;
+    }
+
+    BoundsBlock bounds;
+    std::memcpy(&bounds, bytes + header.boundsOffset, sizeof(bounds));
+    out.m_BoundsMin = glm::vec3(bounds.min[0], bounds.min[1], bounds.min[2]);
+    out.m_BoundsMax = glm::vec3(bounds.max[0], bounds.max[1], bounds.max[2]);
+    out.m_Vertices = reinterpret_cast<const float*>(bytes + header.vertexOffset);
+    out.m_VertexFloatCount = static_cast<size_t>(header.vertexCount * FLOATS_PER_VERTEX);
+    out.m_Indices = indices;
+    out.m_IndexCount = static_cast<size_t>(header.indexCount);
+    return true;
+}
+
+bool MeshCache::Store(const Key& key, const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+{
+    if (!GetSettings().enabled || vertices.size() % FLOATS_PER_VERTEX != 0) return false;
+
+    std::error_code ec;
+    fs::create_directories(GetSettings().directory, ec);
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.floatsPerVertex = FLOATS_PER_VERTEX;
+    header.keyHash = key.hash();
+    header.vertexCount = vertices.size() / FLOATS_PER_VERTEX;
+    header.indexCount = indices.size();
+    header.boundsOffset = sizeof(FileHeader);
+    header.vertexOffset = AlignUp(header.boundsOffset + sizeof(BoundsBlock));
+    header.indexOffset = AlignUp(header.vertexOffset + vertices.size() * sizeof(float));
+    header.fileSize = header.indexOffset + indices.size() * sizeof(unsigned int);
+
+    BoundsBlock bounds{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    for (size_t v = 0; v < header.vertexCount; ++v)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float value = vertices[v * FLOATS_PER_VERTEX + axis];
+            bounds.min[axis] = v == 0 ? value : std::min(bounds.min[axis], value);
+            bounds.max[axis] = v == 0 ? value : std::max(bounds.max[axis], value);
+        }
+    }
+
+    const fs::path path = EntryPath(key);
+    fs::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "MeshCache: não foi possível criar " << temporary.string() << '\n';
+            return false;
+        }
+
+        const char padding[BLOB_ALIGNMENT] = {};
+        auto padTo = [&](const uint64_t offset)
+        {
+            const auto position = static_cast<uint64_t>(file.tellp());
+            file.write(padding, static_cast<std::streamsize>(offset - position));
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&bounds), sizeof(bounds));
+        padTo(header.vertexOffset);
+        file.write(reinterpret_cast<const char*>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(float)));
+        padTo(header.indexOffset);
+        file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(unsigned int)));
+
+        if (!file)
+        {
+            file.close();
+            fs::remove(temporary, ec);
+            std::cerr << "MeshCache: falha ao gravar " << temporary.string() << '\n';
+            return false;
+        }
+    }
+
+    fs::rename(temporary, path, ec);
+    if (ec)
+    {
+        fs::remove(temporary, ec);
+        return false;
+    }
+
+    EnforceSizeCap(path);
+    return true;
+}
+
+void MeshCache::Invalidate(const Key& key)
+{
+    std::error_code ec;
+    fs::remove(EntryPath(key), ec);
+}
+
+void MeshCache::Clear()
+{
+    std::error_code ec;
+    std::vector<fs::path> entries;
+    for (const auto& item : fs::directory_iterator(GetSettings().directory, ec))
+    {
+        const fs::path& path = item.path();
+        if (path.extension() == EXTENSION || (path.extension() == ".tmp" && path.stem().extension() == EXTENSION))
+            entries.push_back(path);
+    }
+    for (const fs::path& path : entries) fs::remove(path, ec);
+}
@@ -0,0 +1,38 @@
+#include "Object/Meshes/MeshQuality.h"
+
+#include <cstring>
+
+#include "Object/Meshes/Mesh.h"
+#include "Simplification/Simplification.h"
+
+MeshQuality::Settings& MeshQuality::GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+bool MeshQuality::Parse(const char* name, Level& out)
+{
+    if (std::strcmp(name, "full") == 0) out = Level::Full;
+    else if (std::strcmp(name, "balanced") == 0) out = Level::Balanced;
+    else if (std::strcmp(name, "draft") == 0) out = Level::Draft;
+    else return false;
+    return true;
+}
+
+void MeshQuality::AddToKey(MeshCache::Key& key)
+{
+    key.add(static_cast<int>(GetSettings().level));
+}
+
+void MeshQuality::Apply(const MeshLevel& level, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+{
+    const Level quality = GetSettings().level;
+    if (quality == Level::Full || level.resolution > 0) return;
+
+    Simplification::Settings settings;
+    settings.maxError = quality == Level::Draft ? 1e-3f : 1e-4f;
+    settings.threadCount = 0;
+    settings.cancel = level.cancel;
+    Simplification::SimplifyMesh(vertices, indices, settings);
+}
@@ -0,0 +1,222 @@
+#include "Object/Meshes/MeshRefiner.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Object/Meshes/Mesh.h"
+#include "Object/Meshes/MeshRegistry.h"
+
+namespace MeshRefiner
+{
+    // Uma thread em segundo plano gera as tarefas na ordem de envio; cada geração ainda se espalha pelo
+    // pool de threads do Polygonizer, então uma thread só basta para manter todos os núcleos ocupados
+    class Worker
+    {
+    public:
+        ~Worker() { stop(); }
+
+        std::shared_ptr<Job> submit(std::shared_ptr<Job> job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Queue.push_back(job);
+                m_Jobs.push_back(job);
+                if (!m_Thread.joinable())
+                {
+                    m_Stop = false;
+                    m_Thread = std::thread([this] { run(); });
+                }
+            }
+            m_Wake.notify_one();
+            return job;
+        }
+
+        size_t processCompleted()
+        {
+            std::vector<std::shared_ptr<Job>> ready;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                ready.swap(m_Ready);
+            }
+
+            size_t swapped = 0;
+            for (const auto& job : ready)
+            {
+                // A geração terminou, então o resultado vale mesmo que a malha que o pediu já não exista;
+                // só é descartado quando nada mais desenha estes buffers
+                if (const auto target = job->m_Target.lock())
+                {
+                    target->upload(job->m_Vertices.data(), job->m_Vertices.size(), job->m_Indices.data(), job->m_Indices.size());
+                    job->m_State = JobState::Done;
+                    ++swapped;
+                }
+                else
+                {
+                    job->m_State = JobState::Cancelled;
+                }
+                std::vector<float>().swap(job->m_Vertices);
+                std::vector<unsigned int>().swap(job->m_Indices);
+            }
+            return swapped;
+        }
+
+        Status status()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            pruneFinished();
+
+            Status status;
+            status.pending = m_Jobs.size();
+            if (!m_Jobs.empty())
+            {
+                // Tarefas terminadas neste lote continuam contando inteiras, então o número nunca volta
+                float sum = static_cast<float>(m_FinishedInBatch);
+                for (const auto& job : m_Jobs) sum += job->progress();
+                status.progress = sum / static_cast<float>(m_Jobs.size() + m_FinishedInBatch);
+            }
+            return status;
+        }
+
+        void stop()
+        {
+            std::thread thread;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (const auto& job : m_Jobs) job->cancel();
+                m_Stop = true;
+                thread = std::move(m_Thread);
+            }
+            m_Wake.notify_one();
+            if (thread.joinable()) thread.join();
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (const auto& job : m_Jobs)
+                if (job->state() != JobState::Done) job->m_State = JobState::Cancelled;
+            m_Queue.clear();
+            m_Ready.clear();
+            m_Jobs.clear();
+            m_FinishedInBatch = 0;
+        }
+
+    private:
+        void run()
+        {
+            for (;;)
+            {
+                std::shared_ptr<Job> job;
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Wake.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+                    if (m_Stop) return;
+                    job = std::move(m_Queue.front());
+                    m_Queue.pop_front();
+                }
+
+                if (build(*job))
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    m_Ready.push_back(std::move(job));
+                }
+            }
+        }
+
+        static bool build(Job& job)
+        {
+            if (job.m_Cancel || job.m_Target.expired())
+            {
+                job.m_State = JobState::Cancelled;
+                return false;
+            }
+            job.m_State = JobState::Running;
+
+            MeshLevel level;
+            level.progress = &job.m_Progress;
+            level.cancel = &job.m_Cancel;
+            std::vector<float> vertices;
+            std::vector<unsigned int> indices;
+            const bool built = job.m_Build(level, vertices, indices) && !job.m_Cancel;
+
+            // O que o construtor capturou é liberado assim que ele termina, não quando a tarefa é descartada
+            job.m_Build = nullptr;
+            if (!built)
+            {
+                job.m_State = JobState::Cancelled;
+                return false;
+            }
+
+            // A gravação em disco fica fora da thread do GL; a próxima execução carrega a malha completa direto
+            if (job.m_Keyed) MeshCache::Store(job.m_CacheKey, vertices, indices);
+
+            job.m_Vertices = std::move(vertices);
+            job.m_Indices = std::move(indices);
+            job.m_Progress = 1.0f;
+            job.m_State = JobState::Ready;
+            return true;
+        }
+
+        // Descarta as tarefas que não precisam mais do refinador (trocadas ou canceladas)
+        void pruneFinished()
+        {
+            for (auto it = m_Jobs.begin(); it != m_Jobs.end();)
+            {
+                const JobState state = (*it)->state();
+                const bool finished = state == JobState::Done || state == JobState::Cancelled;
+                m_FinishedInBatch += finished;
+                it = finished ? m_Jobs.erase(it) : std::next(it);
+            }
+            if (m_Jobs.empty()) m_FinishedInBatch = 0;
+        }
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        std::thread m_Thread;
+        bool m_Stop = false;
+
+        std::deque<std::shared_ptr<Job>> m_Queue;
+        std::vector<std::shared_ptr<Job>> m_Ready;
+        std::vector<std::shared_ptr<Job>> m_Jobs;
+        size_t m_FinishedInBatch = 0;
+    };
+
+    namespace
+    {
+        Worker& GetWorker()
+        {
+            static Worker worker;
+            return worker;
+        }
+    }
+}
+
+MeshRefiner::Settings& MeshRefiner::GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+MeshRefiner::Job::Job(BuildFunction build, std::weak_ptr<MeshBuffers> target, const MeshCache::Key* cacheKey)
+    : m_Build(std::move(build)), m_Target(std::move(target)), m_CacheKey(cacheKey ? *cacheKey : MeshCache::Key("")),
+      m_Keyed(cacheKey != nullptr) {}
+
+std::shared_ptr<MeshRefiner::Job> MeshRefiner::Submit(BuildFunction build, std::weak_ptr<MeshBuffers> target, const MeshCache::Key* cacheKey)
+{
+    return GetWorker().submit(std::make_shared<Job>(std::move(build), std::move(target), cacheKey));
+}
+
+size_t MeshRefiner::ProcessCompleted()
+{
+    return GetWorker().processCompleted();
+}
+
+MeshRefiner::Status MeshRefiner::GetStatus()
+{
+    return GetWorker().status();
+}
+
+void MeshRefiner::Shutdown()
+{
+    GetWorker().stop();
+}
@@ -0,0 +1,111 @@
+#include "Object/Meshes/MeshRegistry.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "glad/glad.h"
+#include "Object/Meshes/MeshRefiner.h"
+#include "Utility/Containers/WeakRegistry.h"
+
+namespace
+{
+    WeakRegistry<uint64_t, MeshBuffers>& Entries()
+    {
+        static WeakRegistry<uint64_t, MeshBuffers> entries;
+        return entries;
+    }
+
+    // Último VAO ligado pelo MeshRegistry::BindVertexArray
+    unsigned int s_BoundVertexArray = 0;
+}
+
+MeshBuffers::~MeshBuffers()
+{
+    // Nada vai desenhar a malha final; a geração só segura a própria cópia do construtor, então não precisa esperar
+    if (refinement) refinement->cancel();
+    if (ebo) glDeleteBuffers(1, &ebo);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    // Apagar o VAO ligado devolve a ligação a 0
+    if (vao && s_BoundVertexArray == vao) s_BoundVertexArray = 0;
+}
+
+void MeshBuffers::upload(const float* vertices, const size_t vertexFloatCount, const unsigned int* indices, const size_t count)
+{
+    const bool created = vao == 0;
+    if (created)
+    {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ebo);
+    }
+    indexCount = static_cast<unsigned int>(count);
+    const size_t vertexCount = vertexFloatCount / 8;
+
+    // A conversão acontece aqui, na thread do GL, para o cache em disco e o refinador ficarem com o layout simples em floats
+    std::vector<VertexFormat::PackedVertex> packed;
+    const void* vertexData = vertices;
+    size_t vertexBytes = sizeof(float) * vertexFloatCount;
+    dequantization = VertexFormat::Dequantization{};
+    if (layout == VertexFormat::Layout::Packed)
+    {
+        dequantization = VertexFormat::PackVertices(vertices, vertexCount, packed);
+        vertexData = packed.data();
+        vertexBytes = sizeof(VertexFormat::PackedVertex) * packed.size();
+    }
+
+    std::vector<uint16_t> narrow;
+    shortIndices = VertexFormat::NarrowIndices(indices, count, vertexCount, narrow);
+    const void* indexData = shortIndices ? static_cast<const void*>(narrow.data()) : indices;
+    const size_t indexBytes = (shortIndices ? sizeof(uint16_t) : sizeof(unsigned int)) * count;
+
+    MeshRegistry::BindVertexArray(vao);
+
+    // Mesmos objetos de buffer numa atualização: o VAO continua apontando para eles, só o armazenamento é trocado
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexBytes), vertexData, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), indexData, GL_STATIC_DRAW);
+
+    if (created) VertexFormat::SetupAttributes(layout);
+
+    MeshRegistry::BindVertexArray(0);
+
+    gpuBytes = vertexBytes + indexBytes;
+    float32Bytes = sizeof(float) * vertexFloatCount + sizeof(unsigned int) * count;
+    if (VertexFormat::GetSettings().report && float32Bytes > 0)
+    {
+        // Todo desenho lê o buffer de índices inteiro e cada vértice referenciado pelo menos uma vez, então a economia
+        // de memória também é a economia mínima de banda de leitura de vértices por desenho
+        std::cout << "Malha " << label << ": " << vertexCount << " vértices, " << count / 3 << " triângulos, "
+                  << VertexFormat::Stride(layout) << " B/vértice, índices de " << (shortIndices ? 16 : 32) << " bits: "
+                  << std::fixed << std::setprecision(1) << float32Bytes / 1024.0 << " KiB -> " << gpuBytes / 1024.0
+                  << " KiB (" << std::setprecision(0) << 100.0 * (1.0 - static_cast<double>(gpuBytes) / float32Bytes)
+                  << "% a menos de VRAM e de leitura por desenho)" << std::defaultfloat << std::endl;
+    }
+}
+
+std::shared_ptr<MeshBuffers> MeshRegistry::Find(const uint64_t key)
+{
+    return Entries().find(key);
+}
+
+void MeshRegistry::Add(const uint64_t key, const std::shared_ptr<MeshBuffers>& buffers)
+{
+    Entries().add(key, buffers);
+}
+
+size_t MeshRegistry::LiveCount()
+{
+    return Entries().liveCount();
+}
+
+bool MeshRegistry::BindVertexArray(const unsigned int vao)
+{
+    if (s_BoundVertexArray == vao) return false;
+    glBindVertexArray(vao);
+    s_BoundVertexArray = vao;
+    return true;
+}
@@ -0,0 +1,118 @@
+#include "Object/Meshes/VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "glad/glad.h"
+
+namespace
+{
+    constexpr float SNORM16 = 32767.0f;
+
+    int16_t QuantizeSnorm(const float value)
+    {
+        return static_cast<int16_t>(std::lround(glm::clamp(value, -1.0f, 1.0f) * SNORM16));
+    }
+
+    // Mapeamento octaédrico: a esfera unitária é projetada no octaedro |x| + |y| + |z| = 1 e a metade de baixo é
+    // dobrada sobre a de cima, então dois valores cobrem todas as direções com precisão quase uniforme
+    glm::vec2 OctEncode(glm::vec3 n)
+    {
+        const float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+        if (l1 <= 0.0f) return glm::vec2(0.0f);
+        n /= l1;
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f) {
+            e = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * glm::vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+        }
+        return e;
+    }
+}
+
+VertexFormat::Settings& VertexFormat::GetSettings()
+{
+    static Settings settings;
+    return settings;
+}
+
+bool VertexFormat::Parse(const char* name, Layout& out)
+{
+    if (std::strcmp(name, "float") == 0) out = Layout::Float32;
+    else if (std::strcmp(name, "packed") == 0) out = Layout::Packed;
+    else return false;
+    return true;
+}
+
+VertexFormat::Dequantization VertexFormat::PackVertices(const float* vertices, const size_t vertexCount, std::vector<PackedVertex>& out)
+{
+    glm::vec3 lo(0.0f), hi(0.0f);
+    for (size_t v = 0; v < vertexCount; v++) {
+        const glm::vec3 p(vertices[v * 8], vertices[v * 8 + 1], vertices[v * 8 + 2]);
+        lo = v ? glm::min(lo, p) : p;
+        hi = v ? glm::max(hi, p) : p;
+    }
+
+    Dequantization dq;
+    dq.offset = 0.5f * (lo + hi);
+    // Um eixo achatado (p. ex. um plano) ainda ganha uma escala não nula, então toda coordenada vira 0 e decodifica para o offset
+    const glm::vec3 half = glm::max(0.5f * (hi - lo), glm::vec3(1e-20f));
+    dq.scale = half / SNORM16;
+
+    out.resize(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        const float* in = vertices + v * 8;
+        PackedVertex& pv = out[v];
+        for (int a = 0; a < 3; a++) pv.position[a] = QuantizeSnorm((in[a] - dq.offset[a]) / half[a]);
+        pv.padding = 0;
+        const glm::vec2 oct = OctEncode(glm::vec3(in[3], in[4], in[5]));
+        pv.normal[0] = QuantizeSnorm(oct.x);
+        pv.normal[1] = QuantizeSnorm(oct.y);
+        pv.uv[0] = glm::packHalf1x16(in[6]);
+        pv.uv[1] = glm::packHalf1x16(in[7]);
+    }
+    return dq;
+}
+
+bool VertexFormat::NarrowIndices(const unsigned int* indices, const size_t indexCount, const size_t vertexCount, std::vector<uint16_t>& out)
+{
+    out.clear();
+    if (vertexCount > 0x10000) return false;
+    out.resize(indexCount);
+    for (size_t i = 0; i < indexCount; i++) out[i] = static_cast<uint16_t>(indices[i]);
+    return true;
+}
+
+size_t VertexFormat::Stride(const Layout layout)
+{
+    return layout == Layout::Packed ? sizeof(PackedVertex) : 8 * sizeof(float);
+}
+
+void VertexFormat::SetupAttributes(const Layout layout)
+{
+    if (layout == Layout::Packed)
+    {
+        constexpr GLsizei stride = sizeof(PackedVertex);
+
+        // Posição - Layout 0: inteiros, o shader aplica a escala da malha
+        glVertexAttribPointer(0, 3, GL_SHORT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, position)));
+        // Normal - Layout 1: só x e y do octaedro (z chega 0), decodificada no shader
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, normal)));
+        // Texture Coord - Layout 2
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(PackedVertex, uv)));
+    }
+    else
+    {
+        // Layout: Position (3 Floats), Normal (3 Floats), Texture Coord (2 Floats).
+        constexpr GLsizei stride = 8 * sizeof(float);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, static_cast<void*>(nullptr));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
+    }
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+}
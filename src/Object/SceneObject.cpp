@@ -30,10 +30,9 @@ SceneObject::SceneObject(const std::string& name, Transform transform, Mesh* mes
     m_Name = name;
 }
 
-void SceneObject::Draw(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& cameraPosition,
-                       const std::vector<Light>& lights) const
+void SceneObject::Draw() const
 {
-    m_Mesh->render(viewMatrix, projectionMatrix, m_Transform.getModelMatrix(), lights, cameraPosition);
+    m_Mesh->render(m_Transform.getModelMatrix());
 }
 
 void SceneObject::AddComponent(std::unique_ptr<IComponent> component)
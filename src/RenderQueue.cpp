@@ -0,0 +1,61 @@
+#include "RenderQueue.h"
+
+#include <glad/glad.h>
+
+#include "Object/Meshes/Mesh.h"
+
+void RenderQueue::clear()
+{
+    m_items.clear();
+    m_keys.clear();
+}
+
+void RenderQueue::add(Mesh& mesh, const glm::mat4& modelMatrix, const float depth)
+{
+    const unsigned int vertexArray = mesh.getVertexArray();
+    if (vertexArray == 0) return;
+
+    const Material& material = mesh.getMaterial();
+    Item item{ &mesh, modelMatrix, material.shader.ID, material.diffuseMap.getId(), vertexArray };
+    m_keys.push_back(MakeKey(material.transparent, item.program, item.texture, item.vertexArray, depth));
+    m_items.push_back(item);
+}
+
+void RenderQueue::submit()
+{
+    m_stats = Stats{};
+    SortByKey(m_keys, m_order, m_scratch);
+
+    const Item* previous = nullptr;
+    bool blending = false;
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+
+    for (const uint32_t index : m_order)
+    {
+        const Item& item = m_items[index];
+        const bool transparent = (m_keys[index] >> 63) != 0;
+        if (transparent && !blending)
+        {
+            // Passo transparente: mistura com o que já está lá, sem esconder o que é desenhado depois
+            glEnable(GL_BLEND);
+            glDepthMask(GL_FALSE);
+            blending = true;
+        }
+
+        m_stats.programSwitches += !previous || previous->program != item.program;
+        m_stats.textureSwitches += !previous || previous->texture != item.texture;
+        m_stats.meshSwitches += !previous || previous->vertexArray != item.vertexArray;
+        ++(transparent ? m_stats.transparent : m_stats.opaque);
+        ++m_stats.draws;
+
+        item.mesh->render(item.modelMatrix);
+        previous = &item;
+    }
+
+    if (blending)
+    {
+        glDisable(GL_BLEND);
+        glDepthMask(GL_TRUE);
+    }
+}
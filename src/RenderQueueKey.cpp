@@ -0,0 +1,65 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+// Chave e ordenação da RenderQueue, sem OpenGL (o RenderQueueTest compila só este arquivo)
+namespace
+{
+    constexpr int PROGRAM_BITS = 12, TEXTURE_BITS = 12, MESH_BITS = 14, DEPTH_BITS = 25;
+    static_assert(1 + PROGRAM_BITS + TEXTURE_BITS + MESH_BITS + DEPTH_BITS <= 64, "a chave tem 64 bits");
+
+    uint64_t Field(const unsigned int value, const int bits)
+    {
+        return static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1);
+    }
+
+    // Os bits de um float não negativo ordenam como o próprio float; os 25 de cima dos 31 bastam para ordenar desenhos
+    uint64_t QuantizeDepth(float depth)
+    {
+        if (!(depth > 0.0f)) depth = 0.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> (31 - DEPTH_BITS);
+    }
+}
+
+uint64_t RenderQueue::MakeKey(const bool transparent, const unsigned int program, const unsigned int texture, const unsigned int mesh,
+    const float depth)
+{
+    const uint64_t state = (Field(program, PROGRAM_BITS) << (TEXTURE_BITS + MESH_BITS))
+        | (Field(texture, TEXTURE_BITS) << MESH_BITS) | Field(mesh, MESH_BITS);
+    const uint64_t z = QuantizeDepth(depth);
+
+    // Opacos: estado primeiro, depois da frente para trás. Transparentes: de trás para frente, o estado só desempata
+    if (!transparent) return (state << DEPTH_BITS) | z;
+    const uint64_t farFirst = ~z & ((uint64_t(1) << DEPTH_BITS) - 1);
+    return (uint64_t(1) << 63) | (farFirst << (PROGRAM_BITS + TEXTURE_BITS + MESH_BITS)) | state;
+}
+
+void RenderQueue::SortByKey(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch)
+{
+    const size_t n = keys.size();
+    order.resize(n);
+    scratch.resize(n);
+    for (size_t i = 0; i < n; ++i) order[i] = static_cast<uint32_t>(i);
+    if (n < 2) return;
+
+    // Radix sort LSD, um byte por passada
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (const uint64_t key : keys) ++counts[(key >> shift) & 0xFF];
+        // Todas as chaves com o mesmo byte (a maioria das passadas, com poucos programas e texturas): nada muda
+        if (counts[(keys[0] >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (size_t& count : counts)
+        {
+            const size_t c = count;
+            count = offset;
+            offset += c;
+        }
+        for (const uint32_t index : order) scratch[counts[(keys[index] >> shift) & 0xFF]++] = index;
+        order.swap(scratch);
+    }
+}
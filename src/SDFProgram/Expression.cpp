@@ -0,0 +1,87 @@
+#include "SDFProgram/Expression.h"
+
+namespace
+{
+    using namespace SDFProgram;
+
+    Expr MakeNode(const NodeKind kind, std::vector<float> params,
+        std::shared_ptr<const Node> a = nullptr, std::shared_ptr<const Node> b = nullptr)
+    {
+        return Expr(std::make_shared<const Node>(Node{ kind, std::move(params), std::move(a), std::move(b) }));
+    }
+}
+
+Expr SDFProgram::Box(const glm::vec3& halfExtents)
+{
+    return MakeNode(NodeKind::Box, { halfExtents.x, halfExtents.y, halfExtents.z });
+}
+
+Expr SDFProgram::BoxExtruded(const float hx, const float hz, const float heightY)
+{
+    return MakeNode(NodeKind::BoxExtruded, { hx, hz, heightY });
+}
+
+Expr SDFProgram::Cylinder(const glm::vec3& a, const glm::vec3& b, const float r)
+{
+    return MakeNode(NodeKind::Cylinder, { a.x, a.y, a.z, b.x, b.y, b.z, r });
+}
+
+Expr SDFProgram::CappedCylinder(const glm::vec3& a, const glm::vec3& b, const float r)
+{
+    return MakeNode(NodeKind::CappedCylinder, { a.x, a.y, a.z, b.x, b.y, b.z, r });
+}
+
+Expr SDFProgram::CappedEllipticalCylinder(const float rx, const float ry, const float depth)
+{
+    return MakeNode(NodeKind::CappedEllipticalCylinder, { rx, ry, depth });
+}
+
+Expr SDFProgram::TruncatedPrism(const glm::vec2& base, const glm::vec2& top, const float height)
+{
+    return MakeNode(NodeKind::TruncatedPrism, { base.x, base.y, top.x, top.y, height });
+}
+
+Expr SDFProgram::Plane(const glm::vec3& n, const float offset)
+{
+    return MakeNode(NodeKind::Plane, { n.x, n.y, n.z, offset });
+}
+
+Expr SDFProgram::RightTrianglePrism(const glm::vec2& baseXZ, const float heightY)
+{
+    return MakeNode(NodeKind::RightTrianglePrism, { baseXZ.x, baseXZ.y, heightY });
+}
+
+Expr SDFProgram::RotatedRightTriangle(const glm::vec2& baseXZ, const float heightY, const float angleDeg)
+{
+    return MakeNode(NodeKind::RotatedRightTriangle, { baseXZ.x, baseXZ.y, heightY, angleDeg });
+}
+
+Expr SDFProgram::Wedge(const float hx, const float hz, const float heightY)
+{
+    return MakeNode(NodeKind::Wedge, { hx, hz, heightY });
+}
+
+Expr SDFProgram::Union(const Expr& a, const Expr& b)
+{
+    return MakeNode(NodeKind::Union, {}, a.shared(), b.shared());
+}
+
+Expr SDFProgram::Intersection(const Expr& a, const Expr& b)
+{
+    return MakeNode(NodeKind::Intersection, {}, a.shared(), b.shared());
+}
+
+Expr SDFProgram::Subtract(const Expr& a, const Expr& b)
+{
+    return MakeNode(NodeKind::Subtract, {}, a.shared(), b.shared());
+}
+
+Expr SDFProgram::Translate(const Expr& e, const glm::vec3& offset)
+{
+    return MakeNode(NodeKind::Translate, { offset.x, offset.y, offset.z }, e.shared());
+}
+
+Expr SDFProgram::RotateZ(const Expr& e, const float angleDeg)
+{
+    return MakeNode(NodeKind::RotateZ, { angleDeg }, e.shared());
+}
@@ -0,0 +1,442 @@
+#include "SDFProgram/Program.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+#include "Object/Meshes/CSGImplementable.h"
+#include "Utility/Math/Dual3.h"
+#include "Utility/SIMD/FloatLanes.h"
+
+namespace
+{
+    using namespace SDFProgram;
+    using MathUtils::GenericVec3;
+    using MathUtils::Interval;
+
+    // O interpretador roda exatamente as mesmas primitivas genéricas que os glifos escritos à mão usam
+    struct Kernels : CSGImplementable
+    {
+        using CSGImplementable::opUnion;
+        using CSGImplementable::opIntersection;
+        using CSGImplementable::opSubtract;
+        using CSGImplementable::boxSDF;
+        using CSGImplementable::boxExtrudedSDF;
+        using CSGImplementable::cylinderSDF;
+        using CSGImplementable::cappedCylinderSDF;
+        using CSGImplementable::cappedEllipticalCylinderSDF;
+        using CSGImplementable::truncatedPrismSDF;
+        using CSGImplementable::planeSDF;
+        using CSGImplementable::rightTrianglePrismSDF;
+        using CSGImplementable::rotatedRightTriangleSDF;
+        using CSGImplementable::wedgeSDF;
+    };
+
+    // As pontas dos intervalos são arredondadas como as próprias amostras, então um ramo só vence um min/max
+    // quando está à frente por bem mais que o erro de arredondamento de uma distância do tamanho de um glifo
+    constexpr float PRUNE_MARGIN = 1e-4f;
+
+    bool IsPointOp(const OpCode op) { return op == OpCode::Translate || op == OpCode::RotateZ; }
+    bool IsCombinator(const OpCode op) { return op >= OpCode::Union; }
+
+    // Buffers do interpretador por thread; o Polygonizer chama evaluate() de todas as threads do pool
+    struct Scratch
+    {
+        std::vector<SIMD::Vec3Lanes> laneInput, lanePoints;
+        std::vector<SIMD::FloatLanes> laneValues;
+        std::vector<MathUtils::IntervalVec3> intervalPoints;
+        std::vector<Interval> intervalValues;
+        std::vector<GenericVec3<float>> scalarPoints;
+        std::vector<float> scalarValues;
+        std::vector<MathUtils::DualVec3> dualPoints;
+        std::vector<MathUtils::Dual3> dualValues;
+
+        std::vector<uint16_t> alias;
+        std::vector<char> liveValues, livePoints;
+        std::vector<Instruction> rewritten, trace;
+    };
+
+    Scratch& GetScratch()
+    {
+        thread_local Scratch scratch;
+        return scratch;
+    }
+}
+
+namespace SDFProgram
+{
+    // Achata uma árvore de expressões em bytecode SSA. O mesmo nó sob o mesmo registrador de ponto, e a
+    // mesma transformação do mesmo registrador de ponto, são compilados uma vez só: subexpressões repetidas saem de graça.
+    class Compiler
+    {
+    public:
+        explicit Compiler(Program& program) : m_Program(program) {}
+
+        uint16_t compile(const Node& node, const uint16_t point)
+        {
+            const auto key = std::make_pair(&node, point);
+            const auto it = m_Values.find(key);
+            if (it != m_Values.end()) return it->second;
+
+            uint16_t result;
+            switch (node.kind)
+            {
+            case NodeKind::Translate:
+                result = compile(*node.a, emitPoint(OpCode::Translate, point, node.params));
+                break;
+            case NodeKind::RotateZ:
+            {
+                // Mesmos cos/sin do CSGImplementable::rotateZ, calculados uma vez aqui em vez de a cada amostra
+                const float angle = glm::radians(node.params[0]);
+                result = compile(*node.a, emitPoint(OpCode::RotateZ, point, { std::cos(angle), std::sin(angle) }));
+                break;
+            }
+            case NodeKind::Union:
+            case NodeKind::Intersection:
+            case NodeKind::Subtract:
+            {
+                const uint16_t a = compile(*node.a, point);
+                const uint16_t b = compile(*node.b, point);
+                const OpCode op = node.kind == NodeKind::Union ? OpCode::Union
+                                : node.kind == NodeKind::Intersection ? OpCode::Intersection : OpCode::Subtract;
+                result = emit(op, m_Program.m_ValueRegisters++, a, b, {});
+                break;
+            }
+            default:
+                result = emit(PrimitiveOp(node.kind), m_Program.m_ValueRegisters++, point, 0, node.params);
+                break;
+            }
+
+            m_Values.emplace(key, result);
+            return result;
+        }
+
+    private:
+        static OpCode PrimitiveOp(const NodeKind kind)
+        {
+            switch (kind)
+            {
+            case NodeKind::Box:                      return OpCode::Box;
+            case NodeKind::BoxExtruded:              return OpCode::BoxExtruded;
+            case NodeKind::Cylinder:                 return OpCode::Cylinder;
+            case NodeKind::CappedCylinder:           return OpCode::CappedCylinder;
+            case NodeKind::CappedEllipticalCylinder: return OpCode::CappedEllipticalCylinder;
+            case NodeKind::TruncatedPrism:           return OpCode::TruncatedPrism;
+            case NodeKind::Plane:                    return OpCode::Plane;
+            case NodeKind::RightTrianglePrism:       return OpCode::RightTrianglePrism;
+            case NodeKind::RotatedRightTriangle:     return OpCode::RotatedRightTriangle;
+            case NodeKind::Wedge:                    return OpCode::Wedge;
+            default: throw std::invalid_argument("SDFProgram: nó não é uma primitiva");
+            }
+        }
+
+        uint16_t emitPoint(const OpCode op, const uint16_t point, const std::vector<float>& params)
+        {
+            const auto key = std::make_tuple(op, point, params);
+            const auto it = m_Points.find(key);
+            if (it != m_Points.end()) return it->second;
+
+            const uint16_t result = emit(op, m_Program.m_PointRegisters++, point, 0, params);
+            m_Points.emplace(key, result);
+            return result;
+        }
+
+        uint16_t emit(const OpCode op, const uint16_t dst, const uint16_t a, const uint16_t b, const std::vector<float>& params)
+        {
+            if (m_Program.m_PointRegisters == UINT16_MAX || m_Program.m_ValueRegisters == UINT16_MAX)
+                throw std::length_error("SDFProgram: expressão grande demais");
+
+            m_Program.m_Code.push_back({ op, dst, a, b, static_cast<uint32_t>(m_Program.m_Constants.size()) });
+            m_Program.m_Constants.insert(m_Program.m_Constants.end(), params.begin(), params.end());
+            return dst;
+        }
+
+        Program& m_Program;
+        std::map<std::pair<const Node*, uint16_t>, uint16_t> m_Values;
+        std::map<std::tuple<OpCode, uint16_t, std::vector<float>>, uint16_t> m_Points;
+    };
+}
+
+Program Program::Compile(const Expr& root)
+{
+    Program program;
+    Compiler compiler(program);
+    program.m_Result = compiler.compile(root.node(), 0);
+    // Os filhos são emitidos antes do pai, então a raiz é sempre a última instrução; o
+    // interpretador e o specialize() contam com isso para achar o resultado de um programa (podado)
+    return program;
+}
+
+template<typename S>
+void Program::run(const Instruction* code, const size_t count, const GenericVec3<S>* input, const size_t lanes,
+    std::vector<GenericVec3<S>>& points, std::vector<S>& values) const
+{
+    points.resize(static_cast<size_t>(m_PointRegisters) * lanes);
+    values.resize(static_cast<size_t>(m_ValueRegisters) * lanes);
+    std::copy(input, input + lanes, points.begin());
+
+    auto pointsAt = [&](const uint16_t r) { return points.data() + r * lanes; };
+    auto valuesAt = [&](const uint16_t r) { return values.data() + r * lanes; };
+
+    // Um despacho por instrução, depois um laço apertado sobre todas as lanes do bloco
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Instruction& ins = code[i];
+        const float* c = m_Constants.data() + ins.constants;
+
+        switch (ins.op)
+        {
+        case OpCode::Translate:
+        {
+            const glm::vec3 offset(c[0], c[1], c[2]);
+            const GenericVec3<S>* p = pointsAt(ins.a);
+            GenericVec3<S>* out = pointsAt(ins.dst);
+            for (size_t l = 0; l < lanes; ++l) out[l] = p[l] - offset;
+            break;
+        }
+        case OpCode::RotateZ:
+        {
+            const float ca = c[0], sa = c[1];
+            const GenericVec3<S>* p = pointsAt(ins.a);
+            GenericVec3<S>* out = pointsAt(ins.dst);
+            for (size_t l = 0; l < lanes; ++l)
+                out[l] = { p[l].x * ca - p[l].y * sa, p[l].x * sa + p[l].y * ca, p[l].z };
+            break;
+        }
+
+// As constantes são copiadas para variáveis locais antes: não podem ser aliases dos registradores, então o que a
+// primitiva deriva só delas (comprimento do eixo, direção normalizada...) sai do laço das lanes
+#define SDF_PROGRAM_PRIMITIVE(OP, CONSTANTS, CALL)                                      \
+        case OpCode::OP:                                                                \
+        {                                                                               \
+            CONSTANTS;                                                                  \
+            const GenericVec3<S>* p = pointsAt(ins.a);                                  \
+            S* out = valuesAt(ins.dst);                                                 \
+            for (size_t l = 0; l < lanes; ++l) out[l] = CALL;                           \
+            break;                                                                      \
+        }
+        SDF_PROGRAM_PRIMITIVE(Box,
+            const glm::vec3 b(c[0], c[1], c[2]),
+            Kernels::boxSDF(p[l], b))
+        SDF_PROGRAM_PRIMITIVE(BoxExtruded,
+            const float hx = c[0]; const float hz = c[1]; const float heightY = c[2],
+            Kernels::boxExtrudedSDF(p[l], hx, hz, heightY))
+        SDF_PROGRAM_PRIMITIVE(Cylinder,
+            const glm::vec3 a(c[0], c[1], c[2]); const glm::vec3 b(c[3], c[4], c[5]); const float r = c[6],
+            Kernels::cylinderSDF(p[l], a, b, r))
+        SDF_PROGRAM_PRIMITIVE(CappedCylinder,
+            const glm::vec3 a(c[0], c[1], c[2]); const glm::vec3 b(c[3], c[4], c[5]); const float r = c[6],
+            Kernels::cappedCylinderSDF(p[l], a, b, r))
+        SDF_PROGRAM_PRIMITIVE(CappedEllipticalCylinder,
+            const float rx = c[0]; const float ry = c[1]; const float depth = c[2],
+            Kernels::cappedEllipticalCylinderSDF(p[l], rx, ry, depth))
+        SDF_PROGRAM_PRIMITIVE(TruncatedPrism,
+            const glm::vec2 base(c[0], c[1]); const glm::vec2 top(c[2], c[3]); const float height = c[4],
+            Kernels::truncatedPrismSDF(p[l], base, top, height))
+        SDF_PROGRAM_PRIMITIVE(Plane,
+            const glm::vec3 n(c[0], c[1], c[2]); const float offset = c[3],
+            Kernels::planeSDF(p[l], n, offset))
+        SDF_PROGRAM_PRIMITIVE(RightTrianglePrism,
+            const glm::vec2 baseXZ(c[0], c[1]); const float heightY = c[2],
+            Kernels::rightTrianglePrismSDF(p[l], baseXZ, heightY))
+        SDF_PROGRAM_PRIMITIVE(RotatedRightTriangle,
+            const glm::vec2 baseXZ(c[0], c[1]); const float heightY = c[2]; const float angleDeg = c[3],
+            Kernels::rotatedRightTriangleSDF(p[l], baseXZ, heightY, angleDeg))
+        SDF_PROGRAM_PRIMITIVE(Wedge,
+            const float hx = c[0]; const float hz = c[1]; const float heightY = c[2],
+            Kernels::wedgeSDF(p[l], hx, hz, heightY))
+#undef SDF_PROGRAM_PRIMITIVE
+
+        case OpCode::Union:
+        case OpCode::Intersection:
+        case OpCode::Subtract:
+        {
+            const S* a = valuesAt(ins.a);
+            const S* b = valuesAt(ins.b);
+            S* out = valuesAt(ins.dst);
+            if (ins.op == OpCode::Union)
+                for (size_t l = 0; l < lanes; ++l) out[l] = Kernels::opUnion(a[l], b[l]);
+            else if (ins.op == OpCode::Intersection)
+                for (size_t l = 0; l < lanes; ++l) out[l] = Kernels::opIntersection(a[l], b[l]);
+            else
+                for (size_t l = 0; l < lanes; ++l) out[l] = Kernels::opSubtract(a[l], b[l]);
+            break;
+        }
+        case OpCode::Negate:
+        {
+            const S* a = valuesAt(ins.a);
+            S* out = valuesAt(ins.dst);
+            for (size_t l = 0; l < lanes; ++l) out[l] = -a[l];
+            break;
+        }
+        }
+    }
+}
+
+float Program::operator()(const glm::vec3& p) const
+{
+    Scratch& scratch = GetScratch();
+    const GenericVec3<float> point(p);
+    run(m_Code.data(), m_Code.size(), &point, 1, scratch.scalarPoints, scratch.scalarValues);
+    return scratch.scalarValues[m_Result];
+}
+
+glm::vec3 Program::gradient(const glm::vec3& p) const
+{
+    Scratch& scratch = GetScratch();
+    const MathUtils::DualVec3 point = MathUtils::makeDualPoint(p);
+    run(m_Code.data(), m_Code.size(), &point, 1, scratch.dualPoints, scratch.dualValues);
+    return scratch.dualValues[m_Result].d;
+}
+
+MathUtils::Interval Program::bounds(const glm::vec3& minCorner, const glm::vec3& maxCorner) const
+{
+    Scratch& scratch = GetScratch();
+    const MathUtils::IntervalVec3 box = MathUtils::makeIntervalBox(minCorner, maxCorner);
+    run(m_Code.data(), m_Code.size(), &box, 1, scratch.intervalPoints, scratch.intervalValues);
+    return scratch.intervalValues[m_Result];
+}
+
+void Program::specialize(const glm::vec3& minCorner, const glm::vec3& maxCorner, std::vector<Instruction>& out) const
+{
+    Scratch& scratch = GetScratch();
+    const MathUtils::IntervalVec3 box = MathUtils::makeIntervalBox(minCorner, maxCorner);
+    run(m_Code.data(), m_Code.size(), &box, 1, scratch.intervalPoints, scratch.intervalValues);
+    const std::vector<Interval>& range = scratch.intervalValues;
+
+    // 1) Para frente: um combinador cujo vencedor está decidido na caixa inteira vira um alias desse operando
+    std::vector<uint16_t>& alias = scratch.alias;
+    alias.resize(m_ValueRegisters);
+    for (uint16_t r = 0; r < m_ValueRegisters; ++r) alias[r] = r;
+
+    std::vector<Instruction>& rewritten = scratch.rewritten;
+    rewritten.clear();
+    for (Instruction ins : m_Code)
+    {
+        if (!IsCombinator(ins.op))
+        {
+            rewritten.push_back(ins);
+            continue;
+        }
+
+        const Interval a = range[ins.a], b = range[ins.b];
+        const uint16_t aliasA = alias[ins.a], aliasB = alias[ins.b];
+        if (ins.op == OpCode::Union)
+        {
+            if (a.hi < b.lo - PRUNE_MARGIN) { alias[ins.dst] = aliasA; continue; }
+            if (b.hi < a.lo - PRUNE_MARGIN) { alias[ins.dst] = aliasB; continue; }
+        }
+        else if (ins.op == OpCode::Intersection)
+        {
+            if (a.lo > b.hi + PRUNE_MARGIN) { alias[ins.dst] = aliasA; continue; }
+            if (b.lo > a.hi + PRUNE_MARGIN) { alias[ins.dst] = aliasB; continue; }
+        }
+        else if (ins.op == OpCode::Subtract)
+        {
+            // max(a, -b)
+            if (a.lo > -b.lo + PRUNE_MARGIN) { alias[ins.dst] = aliasA; continue; }
+            if (-b.hi > a.hi + PRUNE_MARGIN)
+            {
+                rewritten.push_back({ OpCode::Negate, ins.dst, aliasB, 0, 0 });
+                continue;
+            }
+        }
+        ins.a = aliasA;
+        ins.b = aliasB;
+        rewritten.push_back(ins);
+    }
+
+    // 2) Para trás: mantém só o que o resultado ainda lê
+    std::vector<char>& liveValues = scratch.liveValues;
+    std::vector<char>& livePoints = scratch.livePoints;
+    liveValues.assign(m_ValueRegisters, 0);
+    livePoints.assign(m_PointRegisters, 0);
+    liveValues[alias[m_Result]] = 1;
+
+    for (auto it = rewritten.rbegin(); it != rewritten.rend(); ++it)
+    {
+        Instruction& ins = *it;
+        const bool live = IsPointOp(ins.op) ? livePoints[ins.dst] : liveValues[ins.dst];
+        if (!live)
+        {
+            // Marcada como morta no lugar; a cópia para frente abaixo a pula
+            ins.dst = UINT16_MAX;
+            continue;
+        }
+        if (IsCombinator(ins.op))
+        {
+            liveValues[ins.a] = 1;
+            if (ins.op != OpCode::Negate) liveValues[ins.b] = 1;
+        }
+        else
+        {
+            livePoints[ins.a] = 1;
+        }
+    }
+
+    out.clear();
+    for (const Instruction& ins : rewritten)
+        if (ins.dst != UINT16_MAX) out.push_back(ins);
+}
+
+void Program::evaluate(const float* xs, const float* ys, const float* zs, float* out, const size_t n) const
+{
+    using SIMD::FloatLanes;
+    constexpr size_t W = FloatLanes::Width;
+    Scratch& scratch = GetScratch();
+
+    for (size_t start = 0; start < n; start += PRUNE_BLOCK)
+    {
+        const size_t count = std::min(PRUNE_BLOCK, n - start);
+        const float* x = xs + start;
+        const float* y = ys + start;
+        const float* z = zs + start;
+
+        const Instruction* code = m_Code.data();
+        size_t codeSize = m_Code.size();
+        if (m_Pruning && m_Code.size() >= MIN_PRUNE_INSTRUCTIONS)
+        {
+            glm::vec3 lo(x[0], y[0], z[0]), hi = lo;
+            for (size_t i = 1; i < count; ++i)
+            {
+                lo = glm::min(lo, glm::vec3(x[i], y[i], z[i]));
+                hi = glm::max(hi, glm::vec3(x[i], y[i], z[i]));
+            }
+            specialize(lo, hi, scratch.trace);
+            code = scratch.trace.data();
+            codeSize = scratch.trace.size();
+        }
+
+        // As lanes depois do fim repetem o último ponto, como o SIMD::evaluateBatch faz
+        const size_t lanes = (count + W - 1) / W;
+        scratch.laneInput.resize(lanes);
+        for (size_t c = 0; c < count / W; ++c)
+            scratch.laneInput[c] = { FloatLanes::load(x + c * W), FloatLanes::load(y + c * W), FloatLanes::load(z + c * W) };
+        if (count % W != 0)
+        {
+            float tx[W], ty[W], tz[W];
+            for (size_t l = 0; l < W; ++l)
+            {
+                const size_t src = std::min(count / W * W + l, count - 1);
+                tx[l] = x[src];
+                ty[l] = y[src];
+                tz[l] = z[src];
+            }
+            scratch.laneInput[lanes - 1] = { FloatLanes::load(tx), FloatLanes::load(ty), FloatLanes::load(tz) };
+        }
+
+        run(code, codeSize, scratch.laneInput.data(), lanes, scratch.lanePoints, scratch.laneValues);
+
+        const FloatLanes* result = scratch.laneValues.data() + code[codeSize - 1].dst * lanes;
+        for (size_t c = 0; c < count / W; ++c)
+            result[c].store(out + start + c * W);
+        if (count % W != 0)
+        {
+            float tout[W];
+            result[lanes - 1].store(tout);
+            std::copy(tout, tout + count % W, out + start + count / W * W);
+        }
+    }
+}
@@ -0,0 +1,229 @@
+#include "ShaderRegistry.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <glad/glad.h>
+
+#include "FrameUniforms.h"
+#include "Utility/Containers/WeakRegistry.h"
+
+namespace
+{
+    struct Registry
+    {
+        WeakRegistry<std::string, ShaderProgram> entries;
+        size_t compiled = 0;
+        // Último programa tornado atual pelo UseProgram
+        unsigned int current = 0;
+        ShaderRegistry::Settings settings;
+        ShaderRegistry::CallStats calls;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Caminhos e defines unidos por um separador que nenhum caminho ou define contém
+    std::string MakeKey(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines)
+    {
+        std::string key = vertexPath + '\n' + fragmentPath;
+        for (const std::string& define : defines) key += '\n' + define;
+        return key;
+    }
+
+    std::string ReadSource(const std::string& path)
+    {
+        std::ifstream file;
+        // Garantir que o ifstream possa lançar exceções
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            file.open(path);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            return stream.str();
+        }
+        catch (std::ifstream::failure&)
+        {
+            std::cout << "ERRO::SHADER::FALHA_AO_LER_ARQUIVO " << path << std::endl;
+            return {};
+        }
+    }
+
+    // O #version tem que continuar na primeira linha, então os defines entram logo depois dele
+    std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines)
+    {
+        if (defines.empty()) return source;
+
+        std::string block;
+        for (const std::string& define : defines) block += "#define " + define + "\n";
+
+        size_t at = 0;
+        const size_t version = source.find("#version");
+        if (version != std::string::npos)
+        {
+            const size_t lineEnd = source.find('\n', version);
+            at = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+        }
+        std::string result = source.substr(0, at);
+        if (at > 0 && result.back() != '\n') result += '\n';
+        return result + block + source.substr(at);
+    }
+
+    void CheckCompileErrors(const unsigned int shader, const std::string& type)
+    {
+        int success;
+        char infoLog[1024];
+        if (type != "PROGRAM")
+        {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success)
+            {
+                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "ERRO::SHADER::COMPILACAO_FALHOU do tipo: " << type << "\n"
+                          << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            }
+        }
+        else
+        {
+            glGetProgramiv(shader, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "ERRO::PROGRAMA::VINCULACAO_FALHOU do tipo: " << type << "\n"
+                          << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            }
+        }
+    }
+
+    // Tabela plana dos uniforms ativos fora de blocos, com uma entrada por elemento de array
+    void Reflect(ShaderProgram& program)
+    {
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(program.id, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(program.id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::vector<char> buffer(static_cast<size_t>(std::max(maxLength, 1)));
+
+        auto add = [&](const std::string& name, const GLint location, const GLenum type)
+        {
+            ShaderProgram::Uniform uniform;
+            uniform.name = name;
+            uniform.location = location;
+            uniform.type = type;
+            program.slots[name] = static_cast<int>(program.uniforms.size());
+            program.uniforms.push_back(uniform);
+        };
+
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program.id, static_cast<GLuint>(i), maxLength, &length, &size, &type, buffer.data());
+            const std::string name(buffer.data(), static_cast<size_t>(length));
+
+            // Membros de uniform blocks não têm location; os valores deles vêm de um buffer
+            const GLint location = glGetUniformLocation(program.id, name.c_str());
+            if (location < 0) continue;
+
+            add(name, location, type);
+            // Arrays de tipos básicos aparecem uma vez só, como "nome[0]" com o seu tamanho
+            const size_t bracket = name.size() > 3 ? name.rfind("[0]") : std::string::npos;
+            if (bracket == std::string::npos || bracket + 3 != name.size()) continue;
+            const std::string base = name.substr(0, bracket);
+            program.slots[base] = program.slot(name);
+            for (GLint element = 1; element < size; ++element)
+            {
+                const std::string elementName = base + "[" + std::to_string(element) + "]";
+                add(elementName, glGetUniformLocation(program.id, elementName.c_str()), type);
+            }
+        }
+    }
+
+    unsigned int CompileStage(const GLenum stage, const std::string& source, const char* type)
+    {
+        const char* code = source.c_str();
+        const unsigned int shader = glCreateShader(stage);
+        glShaderSource(shader, 1, &code, NULL);
+        glCompileShader(shader);
+        CheckCompileErrors(shader, type);
+        return shader;
+    }
+}
+
+ShaderProgram::~ShaderProgram()
+{
+    if (!id) return;
+    glDeleteProgram(id);
+    Registry& registry = GetRegistry();
+    if (registry.current == id) registry.current = 0;
+}
+
+std::shared_ptr<ShaderProgram> ShaderRegistry::Acquire(const std::string& vertexPath, const std::string& fragmentPath,
+    const std::vector<std::string>& defines)
+{
+    Registry& registry = GetRegistry();
+    return registry.entries.acquire(MakeKey(vertexPath, fragmentPath, defines), [&]
+    {
+        // 1. Ler o código dos dois estágios e inserir os defines
+        const std::string vertexCode = InjectDefines(ReadSource(vertexPath), defines);
+        const std::string fragmentCode = InjectDefines(ReadSource(fragmentPath), defines);
+
+        // 2. Compilar e vincular
+        const unsigned int vertex = CompileStage(GL_VERTEX_SHADER, vertexCode, "VERTEX");
+        const unsigned int fragment = CompileStage(GL_FRAGMENT_SHADER, fragmentCode, "FRAGMENT");
+
+        auto program = std::make_shared<ShaderProgram>();
+        program->id = glCreateProgram();
+        glAttachShader(program->id, vertex);
+        glAttachShader(program->id, fragment);
+        glLinkProgram(program->id);
+        CheckCompileErrors(program->id, "PROGRAM");
+        FrameUniforms::BindBlocks(program->id);
+        Reflect(*program);
+
+        // Excluir os shaders, pois já estão vinculados ao programa e não são mais necessários
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+
+        ++registry.compiled;
+        return program;
+    });
+}
+
+size_t ShaderRegistry::LiveCount()
+{
+    return GetRegistry().entries.liveCount();
+}
+
+size_t ShaderRegistry::CompileCount()
+{
+    return GetRegistry().compiled;
+}
+
+void ShaderRegistry::UseProgram(const unsigned int id)
+{
+    Registry& registry = GetRegistry();
+    if (registry.current == id)
+    {
+        ++registry.calls.redundantBinds;
+        return;
+    }
+    glUseProgram(id);
+    registry.current = id;
+    ++registry.calls.programBinds;
+}
+
+ShaderRegistry::Settings& ShaderRegistry::GetSettings()
+{
+    return GetRegistry().settings;
+}
+
+ShaderRegistry::CallStats& ShaderRegistry::GetCallStats()
+{
+    return GetRegistry().calls;
+}
@@ -0,0 +1,617 @@
+#include "Simplification/Simplification.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec3.hpp>
+
+#include "MarchingCubes/Polygonizer.h"
+
+namespace
+{
+    namespace Grid = Polygonizer::Detail;
+
+    // Triângulos por fatia do passe paralelo. A divisão só depende da malha, nunca do número de threads
+    constexpr size_t SLAB_TRIANGLES = 16384;
+    // O plano que passa por uma aresta de borda, perpendicular à sua face, pesa isto a mais que um plano de face
+    constexpr double BOUNDARY_WEIGHT = 10.0;
+    // De quantos em quantos colapsos os laços olham o Settings::cancel
+    constexpr size_t CANCEL_CHECK_INTERVAL = 1024;
+    // Ponto de borda entre fatias, e o escopo do passe final sobre a malha inteira
+    constexpr int BORDER = -1;
+    constexpr unsigned int NO_POINT = 0xFFFFFFFFu;
+
+    // Quádrica de erro 4x4 simétrica de um conjunto de planos com peso (Garland & Heckbert 1997), triângulo superior:
+    // a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+    struct Quadric
+    {
+        double a[10] = {};
+
+        static Quadric Plane(const glm::dvec3& n, const double d, const double w)
+        {
+            Quadric q;
+            q.a[0] = w*n.x*n.x; q.a[1] = w*n.x*n.y; q.a[2] = w*n.x*n.z; q.a[3] = w*n.x*d;
+            q.a[4] = w*n.y*n.y; q.a[5] = w*n.y*n.z; q.a[6] = w*n.y*d;
+            q.a[7] = w*n.z*n.z; q.a[8] = w*n.z*d;
+            q.a[9] = w*d*d;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& o)
+        {
+            for (int i = 0; i < 10; ++i) a[i] += o.a[i];
+            return *this;
+        }
+
+        // Soma ponderada dos quadrados das distâncias de p aos planos
+        double operator()(const glm::dvec3& p) const
+        {
+            return a[0]*p.x*p.x + 2.0*a[1]*p.x*p.y + 2.0*a[2]*p.x*p.z + 2.0*a[3]*p.x
+                 + a[4]*p.y*p.y + 2.0*a[5]*p.y*p.z + 2.0*a[6]*p.y
+                 + a[7]*p.z*p.z + 2.0*a[8]*p.z
+                 + a[9];
+        }
+    };
+
+    // Colapso do ponto `from` no vizinho `to`. O custo é o calculado quando ele entrou na fila; ele é
+    // conferido de novo quando o candidato sai do heap.
+    struct Candidate
+    {
+        float cost;
+        unsigned int from, to;
+    };
+
+    // Ordem de heap mínimo; empates decididos pelas pontas, então a ordem de saída nunca depende da história do heap
+    struct CandidateAfter
+    {
+        bool operator()(const Candidate& a, const Candidate& b) const
+        {
+            if (a.cost != b.cost) return a.cost > b.cost;
+            if (a.from != b.from) return a.from > b.from;
+            return a.to > b.to;
+        }
+    };
+
+    // Buffers por thread de um passe de colapsos
+    struct Scratch
+    {
+        std::vector<unsigned int> around, fromRing, toRing, fromWedges, toWedges, wedgeMap;
+    };
+
+    uint32_t Bits(const float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    // As posições são soldadas em pontos; os vértices de um ponto (as suas cunhas) só diferem em normal ou UV.
+    // Os colapsos movem pontos, os triângulos continuam apontando para cunhas.
+    class Simplifier
+    {
+    public:
+        Simplifier(const std::vector<float>& vertices, const Simplification::Settings& settings)
+            : m_Verts(vertices.data()),
+              m_VertexCount(vertices.size() / 8),
+              m_CosMax(std::cos(glm::radians(settings.maxNormalDeviationDeg))),
+              m_PreserveBoundary(settings.preserveBoundary),
+              m_Cancel(settings.cancel)
+        {
+        }
+
+        // Solda a entrada e calcula as quádricas. Retorna o número de triângulos degenerados descartados.
+        size_t build(const std::vector<unsigned int>& indices, unsigned int threads);
+
+        // Põe cada triângulo numa de `count` fatias ao longo do eixo mais longo; um ponto pertence a uma fatia quando
+        // todos os seus triângulos pertencem, então as fatias podem colapsar os próprios pontos ao mesmo tempo
+        void splitInSlabs(size_t count);
+        void joinSlabs();
+
+        // Colapsos gulosos, do mais barato para o mais caro, até sobrarem `target` triângulos ou o próximo custar
+        // mais que maxCost. slab >= 0 restringe aos pontos daquela fatia, BORDER roda sobre a malha inteira.
+        // Retorna false quando cancelado.
+        bool collapse(int slab, size_t target, double maxCost, size_t& collapses, size_t& rejected);
+
+        bool cancelled() const { return m_Cancel && m_Cancel->load(std::memory_order_relaxed); }
+        size_t liveTriangles() const { return m_Live; }
+        size_t slabTriangles(const int slab) const { return m_SlabLive[slab]; }
+
+        void write(std::vector<float>& vertices, std::vector<unsigned int>& indices) const;
+
+    private:
+        glm::vec3 normal(const unsigned int vertex) const
+        {
+            return glm::vec3(m_Verts[8*vertex + 3], m_Verts[8*vertex + 4], m_Verts[8*vertex + 5]);
+        }
+        unsigned int pointAt(const unsigned int t, const int corner) const { return m_PointOf[m_Tris[t][corner]]; }
+        bool inScope(const unsigned int point, const int slab) const
+        {
+            return !m_PointDead[point] && (slab == BORDER || m_Slab[point] == slab);
+        }
+
+        void compact(unsigned int point);
+        void ring(unsigned int point, std::vector<unsigned int>& out) const;
+        float cost(unsigned int from, unsigned int to) const;
+        void push(std::vector<Candidate>& heap, unsigned int from, unsigned int to) const;
+        // Número de triângulos que o colapso removeu, ou -1 quando foi rejeitado
+        int tryCollapse(unsigned int from, unsigned int to, Scratch& scratch);
+
+        const float* m_Verts;
+        size_t m_VertexCount;
+        float m_CosMax;
+        bool m_PreserveBoundary;
+        const std::atomic<bool>* m_Cancel;
+
+        std::vector<glm::dvec3> m_Position;                 // por ponto
+        std::vector<unsigned int> m_PointOf;                // por vértice
+        std::vector<std::array<unsigned int, 3>> m_Tris;    // cunha de cada canto
+        std::vector<glm::vec3> m_Reference;                 // normal unitária de entrada por triângulo, zero se degenerado
+        std::vector<char> m_TriDead;
+        std::vector<std::vector<unsigned int>> m_PointTris; // pode ter triângulos mortos até ser compactado
+        std::vector<Quadric> m_Quadric;
+        std::vector<double> m_Area;
+        std::vector<char> m_PointDead, m_Locked, m_Boundary;
+        std::vector<int> m_Slab;                            // por ponto: a fatia dona de todos os seus triângulos, ou BORDER
+        std::vector<size_t> m_SlabLive;
+        size_t m_Live = 0;
+    };
+
+    size_t Simplifier::build(const std::vector<unsigned int>& indices, const unsigned int threads)
+    {
+        // 1) Solda: vértices ordenados por posição, depois por normal e UV. Posições iguais dividem um ponto, dados
+        //    iguais dividem uma cunha (o menor índice de vértice da sequência)
+        std::vector<unsigned int> order(m_VertexCount);
+        std::iota(order.begin(), order.end(), 0u);
+        const float* verts = m_Verts;
+        std::sort(order.begin(), order.end(), [verts](const unsigned int a, const unsigned int b)
+        {
+            const float* p = verts + 8*static_cast<size_t>(a);
+            const float* q = verts + 8*static_cast<size_t>(b);
+            for (int c = 0; c < 3; ++c)
+                if (p[c] != q[c]) return p[c] < q[c];
+            for (int c = 3; c < 8; ++c)
+                if (Bits(p[c]) != Bits(q[c])) return Bits(p[c]) < Bits(q[c]);
+            return a < b;
+        });
+
+        std::vector<unsigned int> wedgeOf(m_VertexCount);
+        m_PointOf.assign(m_VertexCount, 0);
+        for (size_t k = 0; k < order.size(); ++k) {
+            const unsigned int v = order[k];
+            const float* p = m_Verts + 8*static_cast<size_t>(v);
+            const float* q = k > 0 ? m_Verts + 8*static_cast<size_t>(order[k - 1]) : nullptr;
+            if (q && p[0] == q[0] && p[1] == q[1] && p[2] == q[2]) {
+                m_PointOf[v] = m_PointOf[order[k - 1]];
+                bool same = true;
+                for (int c = 3; c < 8 && same; ++c) same = Bits(p[c]) == Bits(q[c]);
+                wedgeOf[v] = same ? wedgeOf[order[k - 1]] : v;
+            }
+            else {
+                m_PointOf[v] = static_cast<unsigned int>(m_Position.size());
+                m_Position.emplace_back(p[0], p[1], p[2]);
+                wedgeOf[v] = v;
+            }
+        }
+        const size_t pointCount = m_Position.size();
+
+        // 2) Triângulos sobre cunhas, sem os que têm dois cantos no mesmo ponto
+        size_t degenerate = 0;
+        m_Tris.reserve(indices.size() / 3);
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            const std::array<unsigned int, 3> tri = { wedgeOf[indices[t]], wedgeOf[indices[t + 1]], wedgeOf[indices[t + 2]] };
+            const unsigned int a = m_PointOf[tri[0]], b = m_PointOf[tri[1]], c = m_PointOf[tri[2]];
+            if (a == b || b == c || a == c) {
+                ++degenerate;
+                continue;
+            }
+            m_Tris.push_back(tri);
+        }
+        const size_t triCount = m_Tris.size();
+        m_Live = triCount;
+        m_TriDead.assign(triCount, 0);
+
+        m_PointTris.resize(pointCount);
+        for (unsigned int t = 0; t < triCount; ++t)
+            for (int c = 0; c < 3; ++c)
+                m_PointTris[pointAt(t, c)].push_back(t);
+
+        // 3) Planos das faces
+        m_Reference.resize(triCount);
+        std::vector<double> triArea(triCount);
+        const int triChunks = static_cast<int>(std::min<size_t>(std::max<size_t>(1, triCount / 4096), threads * 4u));
+        Grid::ParallelFor(triChunks, threads, [&](const int chunk)
+        {
+            const size_t end = triCount * (chunk + 1) / triChunks;
+            for (size_t t = triCount * chunk / triChunks; t < end; ++t) {
+                const glm::dvec3 p0 = m_Position[pointAt(t, 0)];
+                const glm::dvec3 e1 = m_Position[pointAt(t, 1)] - p0;
+                const glm::dvec3 e2 = m_Position[pointAt(t, 2)] - p0;
+                const glm::dvec3 c = glm::cross(e1, e2);
+                const double len = glm::length(c);
+                triArea[t] = 0.5 * len;
+                // Lascas mais finas que isto não têm normal confiável; só passam pela verificação de dobra
+                m_Reference[t] = len > 1e-7 * glm::length(e1) * glm::length(e2) ? glm::vec3(c / len) : glm::vec3(0.0f);
+            }
+        });
+
+        // 4) Por ponto: quádrica e área das suas faces, arestas de borda (um triângulo) e não manifold
+        //    (mais de dois), juntadas ponto a ponto para duas threads nunca escreverem no mesmo ponto
+        m_Quadric.resize(pointCount);
+        m_Area.assign(pointCount, 0.0);
+        m_Boundary.assign(pointCount, 0);
+        m_Locked.assign(pointCount, 0);
+        m_PointDead.assign(pointCount, 0);
+        m_Slab.assign(pointCount, 0);
+        const int pointChunks = static_cast<int>(std::min<size_t>(std::max<size_t>(1, pointCount / 4096), threads * 4u));
+        Grid::ParallelFor(pointChunks, threads, [&](const int chunk)
+        {
+            std::vector<std::pair<unsigned int, unsigned int>> edges;   // (outro ponto, triângulo)
+            const size_t end = pointCount * (chunk + 1) / pointChunks;
+            for (size_t p = pointCount * chunk / pointChunks; p < end; ++p) {
+                Quadric q;
+                double area = 0.0;
+                edges.clear();
+                for (const unsigned int t : m_PointTris[p]) {
+                    const glm::dvec3 n = m_Reference[t];
+                    if (triArea[t] > 0.0 && glm::dot(n, n) > 0.5) {
+                        q += Quadric::Plane(n, -glm::dot(n, m_Position[p]), triArea[t]);
+                        area += triArea[t];
+                    }
+                    for (int c = 0; c < 3; ++c)
+                        if (pointAt(t, c) != p) edges.emplace_back(pointAt(t, c), t);
+                }
+
+                std::sort(edges.begin(), edges.end());
+                for (size_t e = 0; e < edges.size(); ) {
+                    size_t run = e + 1;
+                    while (run < edges.size() && edges[run].first == edges[e].first) ++run;
+                    if (run - e > 2) m_Locked[p] = 1;
+                    if (run - e == 1) {
+                        m_Boundary[p] = 1;
+                        const glm::dvec3 along = m_Position[edges[e].first] - m_Position[p];
+                        const glm::dvec3 side = glm::cross(along, glm::dvec3(m_Reference[edges[e].second]));
+                        const double len = glm::length(side);
+                        if (!m_PreserveBoundary && len > 0.0)
+                            q += Quadric::Plane(side / len, -glm::dot(side / len, m_Position[p]), BOUNDARY_WEIGHT * glm::dot(along, along));
+                    }
+                    e = run;
+                }
+                if (m_Boundary[p] && m_PreserveBoundary) m_Locked[p] = 1;
+                m_Quadric[p] = q;
+                m_Area[p] = area;
+            }
+        });
+        return degenerate;
+    }
+
+    void Simplifier::splitInSlabs(const size_t count)
+    {
+        glm::dvec3 lo(std::numeric_limits<double>::max()), hi(-std::numeric_limits<double>::max());
+        for (const glm::dvec3& p : m_Position) {
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        const glm::dvec3 extent = hi - lo;
+        const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+
+        std::vector<int> triSlab(m_Tris.size());
+        m_SlabLive.assign(count, 0);
+        for (size_t t = 0; t < m_Tris.size(); ++t) {
+            const double centroid = (m_Position[pointAt(t, 0)][axis] + m_Position[pointAt(t, 1)][axis] + m_Position[pointAt(t, 2)][axis]) / 3.0;
+            const double f = extent[axis] > 0.0 ? (centroid - lo[axis]) / extent[axis] : 0.0;
+            triSlab[t] = std::min(static_cast<int>(count) - 1, std::max(0, static_cast<int>(f * double(count))));
+            ++m_SlabLive[triSlab[t]];
+        }
+        for (size_t p = 0; p < m_Position.size(); ++p) {
+            const auto& tris = m_PointTris[p];
+            int slab = tris.empty() ? BORDER : triSlab[tris.front()];
+            for (const unsigned int t : tris)
+                if (triSlab[t] != slab) slab = BORDER;
+            m_Slab[p] = slab;
+        }
+    }
+
+    void Simplifier::joinSlabs()
+    {
+        m_Live = 0;
+        for (const size_t live : m_SlabLive) m_Live += live;
+    }
+
+    void Simplifier::compact(const unsigned int point)
+    {
+        auto& tris = m_PointTris[point];
+        tris.erase(std::remove_if(tris.begin(), tris.end(), [this](const unsigned int t) { return m_TriDead[t] != 0; }), tris.end());
+    }
+
+    void Simplifier::ring(const unsigned int point, std::vector<unsigned int>& out) const
+    {
+        out.clear();
+        for (const unsigned int t : m_PointTris[point]) {
+            if (m_TriDead[t]) continue;
+            for (int c = 0; c < 3; ++c)
+                if (pointAt(t, c) != point) out.push_back(pointAt(t, c));
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    float Simplifier::cost(const unsigned int from, const unsigned int to) const
+    {
+        Quadric q = m_Quadric[from];
+        q += m_Quadric[to];
+        const double area = m_Area[from] + m_Area[to];
+        const double error = std::max(0.0, q(m_Position[to]));
+        return static_cast<float>(area > 0.0 ? error / area : error);
+    }
+
+    void Simplifier::push(std::vector<Candidate>& heap, const unsigned int from, const unsigned int to) const
+    {
+        heap.push_back({ cost(from, to), from, to });
+    }
+
+    int Simplifier::tryCollapse(const unsigned int from, const unsigned int to, Scratch& scratch)
+    {
+        if (m_Locked[from]) return -1;
+        compact(from);
+        compact(to);
+        const auto& fromTris = m_PointTris[from];
+
+        // Os triângulos da aresta morrem, os outros recebem `to` no lugar de `from`
+        int shared = 0;
+        for (const unsigned int t : fromTris)
+            if (pointAt(t, 0) == to || pointAt(t, 1) == to || pointAt(t, 2) == to) ++shared;
+        if (shared == 0) return -1;
+        // Um ponto de borda só pode deslizar ao longo da sua própria aresta de borda
+        if (m_Boundary[from] && (shared != 1 || !m_Boundary[to])) return -1;
+
+        // Condição de ligação: os únicos vizinhos comuns aos dois pontos são os cantos opostos dos triângulos que
+        // morrem; qualquer outro estrangularia a superfície. Um leque fechado também precisa de três vizinhos restantes.
+        ring(from, scratch.fromRing);
+        ring(to, scratch.toRing);
+        size_t common = 0;
+        for (size_t a = 0, b = 0; a < scratch.fromRing.size() && b < scratch.toRing.size(); ) {
+            if (scratch.fromRing[a] < scratch.toRing[b]) ++a;
+            else if (scratch.toRing[b] < scratch.fromRing[a]) ++b;
+            else { ++common; ++a; ++b; }
+        }
+        if (common != static_cast<size_t>(shared)) return -1;
+        if (!m_Boundary[from] && scratch.fromRing.size() + scratch.toRing.size() - common - 2 < 3) return -1;
+
+        // Cunhas: cada cunha que `from` mantém vai para a cunha de `to` com a normal mais próxima. Onde um dos pontos
+        // é um vinco (várias cunhas), o par tem que estar dentro do limite de desvio, para os vincos continuarem vivos.
+        auto collect = [this](const unsigned int point, const std::vector<unsigned int>& tris, const unsigned int skip,
+            std::vector<unsigned int>& out)
+        {
+            out.clear();
+            for (const unsigned int t : tris) {
+                bool dying = false;
+                unsigned int wedge = 0;
+                for (int c = 0; c < 3; ++c) {
+                    if (pointAt(t, c) == skip) dying = true;
+                    if (pointAt(t, c) == point) wedge = m_Tris[t][c];
+                }
+                if (!dying) out.push_back(wedge);
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        };
+        collect(from, fromTris, to, scratch.fromWedges);
+        collect(to, m_PointTris[to], from, scratch.toWedges);
+        // Todo triângulo de `to` morre com a aresta: qualquer uma das suas cunhas serve
+        if (scratch.toWedges.empty()) collect(to, m_PointTris[to], NO_POINT, scratch.toWedges);
+
+        const bool crease = scratch.fromWedges.size() > 1 || scratch.toWedges.size() > 1;
+        scratch.wedgeMap.clear();
+        for (const unsigned int wedge : scratch.fromWedges) {
+            const glm::vec3 n = normal(wedge);
+            unsigned int best = scratch.toWedges.front();
+            float bestDot = -2.0f;
+            for (const unsigned int candidate : scratch.toWedges) {
+                const float d = glm::dot(n, normal(candidate));
+                if (d > bestDot) { bestDot = d; best = candidate; }
+            }
+            if (crease && bestDot < m_CosMax) return -1;
+            scratch.wedgeMap.push_back(best);
+        }
+        auto mapped = [&scratch](const unsigned int wedge)
+        {
+            const auto it = std::lower_bound(scratch.fromWedges.begin(), scratch.fromWedges.end(), wedge);
+            return scratch.wedgeMap[it - scratch.fromWedges.begin()];
+        };
+
+        // Faces em volta de `from`: sem lascas, sem dobras, sem girar além do limite em relação à face de entrada
+        const glm::dvec3 target = m_Position[to];
+        for (const unsigned int t : fromTris) {
+            glm::dvec3 p[3];
+            glm::vec3 vertexNormals(0.0f);
+            bool dying = false;
+            for (int c = 0; c < 3; ++c) {
+                const unsigned int point = pointAt(t, c);
+                dying |= point == to;
+                p[c] = point == from ? target : m_Position[point];
+                vertexNormals += normal(point == from ? mapped(m_Tris[t][c]) : m_Tris[t][c]);
+            }
+            if (dying) continue;
+
+            const glm::dvec3 e1 = p[1] - p[0], e2 = p[2] - p[0];
+            const glm::dvec3 c = glm::cross(e1, e2);
+            const double len = glm::length(c);
+            if (!(len > 1e-7 * glm::length(e1) * glm::length(e2))) return -1;
+            const glm::vec3 n = glm::vec3(c / len);
+            const glm::vec3& reference = m_Reference[t];
+            if (glm::dot(reference, reference) > 0.5f ? glm::dot(n, reference) < m_CosMax : glm::dot(n, vertexNormals) <= 0.0f)
+                return -1;
+        }
+
+        // Aplica
+        int removed = 0;
+        auto& toTris = m_PointTris[to];
+        for (const unsigned int t : fromTris) {
+            if (pointAt(t, 0) == to || pointAt(t, 1) == to || pointAt(t, 2) == to) {
+                m_TriDead[t] = 1;
+                ++removed;
+                continue;
+            }
+            for (int c = 0; c < 3; ++c)
+                if (pointAt(t, c) == from) m_Tris[t][c] = mapped(m_Tris[t][c]);
+            toTris.push_back(t);
+        }
+        m_Quadric[to] += m_Quadric[from];
+        m_Area[to] += m_Area[from];
+        m_PointDead[from] = 1;
+        m_PointTris[from].clear();
+        return removed;
+    }
+
+    bool Simplifier::collapse(const int slab, const size_t target, const double maxCost, size_t& collapses, size_t& rejected)
+    {
+        Scratch scratch;
+        std::vector<Candidate> heap;
+        const CandidateAfter after;
+        for (unsigned int p = 0; p < m_Position.size(); ++p) {
+            if (!inScope(p, slab) || m_Locked[p]) continue;
+            ring(p, scratch.around);
+            for (const unsigned int q : scratch.around)
+                if (inScope(q, slab)) push(heap, p, q);
+        }
+        std::make_heap(heap.begin(), heap.end(), after);
+
+        size_t& live = slab == BORDER ? m_Live : m_SlabLive[slab];
+        size_t pops = 0;
+        while (!heap.empty() && live > target) {
+            if (++pops % CANCEL_CHECK_INTERVAL == 0 && cancelled()) return false;
+
+            std::pop_heap(heap.begin(), heap.end(), after);
+            Candidate c = heap.back();
+            heap.pop_back();
+            if (m_PointDead[c.from] || m_PointDead[c.to]) continue;
+
+            // Os custos são atualizados só quando o candidato sai do heap: recalcular todas as arestas do ponto que
+            // ficou a cada colapso deixa as faces planas, onde um ponto acaba com centenas de vizinhos, quadráticas.
+            // Erro e área crescem juntos quando os vizinhos colapsam, então o custo pode subir ou descer; em qualquer
+            // dos casos o candidato volta para o heap com o custo novo
+            const float fresh = cost(c.from, c.to);
+            if (fresh != c.cost) {
+                c.cost = fresh;
+                heap.push_back(c);
+                std::push_heap(heap.begin(), heap.end(), after);
+                continue;
+            }
+            // Os outros candidatos ainda podem ter custo velho, maior que o atual, então o passe não termina aqui
+            if (c.cost > maxCost) continue;
+
+            const int removed = tryCollapse(c.from, c.to, scratch);
+            if (removed < 0) {
+                ++rejected;
+                continue;
+            }
+            live -= static_cast<size_t>(removed);
+            ++collapses;
+
+            // Os vizinhos que `from` tinha e `to` não tinha são arestas novas de `to`
+            for (const unsigned int q : scratch.fromRing) {
+                if (q == c.to || !inScope(q, slab) || std::binary_search(scratch.toRing.begin(), scratch.toRing.end(), q))
+                    continue;
+                if (!m_Locked[c.to]) {
+                    push(heap, c.to, q);
+                    std::push_heap(heap.begin(), heap.end(), after);
+                }
+                if (!m_Locked[q]) {
+                    push(heap, q, c.to);
+                    std::push_heap(heap.begin(), heap.end(), after);
+                }
+            }
+        }
+        return !cancelled();
+    }
+
+    void Simplifier::write(std::vector<float>& vertices, std::vector<unsigned int>& indices) const
+    {
+        // As cunhas que sobram mantêm a ordem relativa; os triângulos também
+        constexpr unsigned int UNUSED = 0xFFFFFFFFu;
+        std::vector<unsigned int> newIndex(m_VertexCount, UNUSED);
+        for (size_t t = 0; t < m_Tris.size(); ++t)
+            if (!m_TriDead[t])
+                for (const unsigned int wedge : m_Tris[t]) newIndex[wedge] = 0;
+
+        std::vector<float> outVerts;
+        unsigned int next = 0;
+        for (size_t v = 0; v < m_VertexCount; ++v) {
+            if (newIndex[v] == UNUSED) continue;
+            newIndex[v] = next++;
+            outVerts.insert(outVerts.end(), m_Verts + 8*v, m_Verts + 8*v + 8);
+        }
+
+        std::vector<unsigned int> outIdx;
+        outIdx.reserve(3 * m_Live);
+        for (size_t t = 0; t < m_Tris.size(); ++t)
+            if (!m_TriDead[t])
+                for (const unsigned int wedge : m_Tris[t]) outIdx.push_back(newIndex[wedge]);
+
+        vertices.swap(outVerts);
+        indices.swap(outIdx);
+    }
+}
+
+void Simplification::SimplifyMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices, const Settings& settings)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const size_t inputTriangles = indices.size() / 3;
+    const size_t inputVertices = vertices.size() / 8;
+    const unsigned int threads = Grid::ResolveThreadCount(settings.threadCount);
+
+    Simplifier simplifier(vertices, settings);
+    const size_t degenerate = simplifier.build(indices, threads);
+
+    const double maxCost = settings.maxError > 0.0f ? double(settings.maxError) * double(settings.maxError)
+        : settings.targetTriangles > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+    const size_t target = settings.targetTriangles;
+    size_t collapses = 0, parallelCollapses = 0, rejected = 0;
+
+    // 1) Malhas grandes: fatias em paralelo, cada uma colapsando só os próprios pontos (as bordas das fatias ficam
+    //    paradas), com a sua parte do alvo
+    const size_t slabCount = simplifier.liveTriangles() / SLAB_TRIANGLES;
+    if (slabCount >= 2) {
+        simplifier.splitInSlabs(slabCount);
+        const size_t live = simplifier.liveTriangles();
+        std::vector<size_t> slabCollapses(slabCount, 0), slabRejected(slabCount, 0);
+        Grid::ParallelFor(static_cast<int>(slabCount), threads, [&](const int s)
+        {
+            const size_t slabTarget = target * simplifier.slabTriangles(s) / live;
+            simplifier.collapse(s, slabTarget, maxCost, slabCollapses[s], slabRejected[s]);
+        });
+        if (simplifier.cancelled()) return;
+        simplifier.joinSlabs();
+        for (size_t s = 0; s < slabCount; ++s) {
+            parallelCollapses += slabCollapses[s];
+            rejected += slabRejected[s];
+        }
+        collapses = parallelCollapses;
+    }
+
+    // 2) A malha inteira, em série: as bordas das fatias e o que o alvo ainda pedir
+    if (!simplifier.collapse(BORDER, target, maxCost, collapses, rejected)) return;
+
+    simplifier.write(vertices, indices);
+
+    if (settings.stats) {
+        Stats& stats = *settings.stats;
+        stats.inputTriangles = inputTriangles;
+        stats.outputTriangles = indices.size() / 3;
+        stats.inputVertices = inputVertices;
+        stats.outputVertices = vertices.size() / 8;
+        stats.degenerateTriangles = degenerate;
+        stats.collapses = collapses;
+        stats.parallelCollapses = parallelCollapses;
+        stats.rejectedCollapses = rejected;
+        stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
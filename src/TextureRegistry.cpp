@@ -0,0 +1,120 @@
+#include "TextureRegistry.h"
+
+#include <iostream>
+#include <vector>
+#include <stb_image/stb_image.h>
+
+#include "Utility/Containers/WeakRegistry.h"
+
+namespace
+{
+    struct Registry
+    {
+        WeakRegistry<std::string, TextureImage> entries;
+        size_t decoded = 0;
+        // Textura ligada a cada unidade e a unidade ativa, como o BindTexture as deixou
+        std::vector<unsigned int> bound;
+        unsigned int activeUnit = 0;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    std::string MakeKey(const std::string& filePath, const SamplerState& sampler)
+    {
+        return filePath + '\n' + std::to_string(sampler.wrapS) + ' ' + std::to_string(sampler.wrapT) + ' '
+            + std::to_string(sampler.minFilter) + ' ' + std::to_string(sampler.magFilter);
+    }
+
+    void Upload(TextureImage& image, const std::string& filePath, const SamplerState& sampler)
+    {
+        // Gerar textura
+        glGenTextures(1, &image.id);
+        TextureRegistry::BindTexture(0, image.id);
+
+        // Configurar parâmetros de textura
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sampler.wrapS);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, sampler.wrapT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampler.minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampler.magFilter);
+
+        // Carregar imagem
+        stbi_set_flip_vertically_on_load(true);
+        unsigned char* data = stbi_load(filePath.c_str(), &image.width, &image.height, &image.channels, 0);
+        if (!data)
+        {
+            std::cerr << "Falha ao carregar textura: " << filePath << std::endl;
+            std::cerr << "Erro STB: " << stbi_failure_reason() << std::endl;
+            return;
+        }
+
+        GLenum format;
+        if (image.channels == 1)
+            format = GL_RED;
+        else if (image.channels == 3)
+            format = GL_RGB;
+        else if (image.channels == 4)
+            format = GL_RGBA;
+        else
+        {
+            std::cerr << "Formato de textura não suportado: " << image.channels << " canais" << std::endl;
+            stbi_image_free(data);
+            return;
+        }
+
+        glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, data);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        stbi_image_free(data);
+        image.loaded = true;
+    }
+}
+
+TextureImage::~TextureImage()
+{
+    if (id == 0) return;
+    glDeleteTextures(1, &id);
+    // Apagar uma textura devolve a 0 toda unidade à qual ela estava ligada
+    for (unsigned int& bound : GetRegistry().bound)
+        if (bound == id) bound = 0;
+}
+
+std::shared_ptr<TextureImage> TextureRegistry::Acquire(const std::string& filePath, const SamplerState& sampler)
+{
+    Registry& registry = GetRegistry();
+    return registry.entries.acquire(MakeKey(filePath, sampler), [&]
+    {
+        auto image = std::make_shared<TextureImage>();
+        Upload(*image, filePath, sampler);
+        ++registry.decoded;
+        return image;
+    });
+}
+
+size_t TextureRegistry::LiveCount()
+{
+    return GetRegistry().entries.liveCount();
+}
+
+size_t TextureRegistry::DecodeCount()
+{
+    return GetRegistry().decoded;
+}
+
+bool TextureRegistry::BindTexture(const unsigned int unit, const unsigned int id)
+{
+    Registry& registry = GetRegistry();
+    if (unit >= registry.bound.size()) registry.bound.resize(unit + 1, 0);
+    if (registry.bound[unit] == id) return false;
+
+    if (registry.activeUnit != unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        registry.activeUnit = unit;
+    }
+    glBindTexture(GL_TEXTURE_2D, id);
+    registry.bound[unit] = id;
+    return true;
+}
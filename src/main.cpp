@@ -25,6 +25,12 @@
 #include "Object/Custom/Letters/AnyLetterObject.h"
 #include "Object/Custom/Numbers/AnyNumberObject.h"
 #include "Object/Meshes/Custom/Sphere.h"
+#include "Object/Meshes/GlyphMesher.h"
+#include "Object/Meshes/MeshCache.h"
+#include "Object/Meshes/MeshQuality.h"
+#include "Object/Meshes/MeshRefiner.h"
+#include "Object/Meshes/VertexFormat.h"
+#include "ShaderRegistry.h"
 #include "Utility/Constants/MathConsts.h"
 
 bool RenderAnimation(const std::string& outputDir, int totalFrames, ViewMode viewMode) {
@@ -44,6 +50,9 @@ bool RenderAnimation(const std::string& outputDir, int totalFrames, ViewMode vie
         std::cerr << "Falha ao inicializar renderer" << '\n';
         return false;
     }
+
+    // Para os refinamentos em andamento em qualquer saída, antes de destruir o contexto OpenGL
+    const MeshRefiner::ScopedShutdown stopRefiner;
     
     // Inicializar câmera
     Camera camera(glm::vec3(0.0f, 1.0f, 0.0f));
@@ -152,6 +161,9 @@ bool RenderAnimation(const std::string& outputDir, int totalFrames, ViewMode vie
             return false;
         }
 
+        // Trocar as prévias pelas malhas finais que ficaram prontas
+        MeshRefiner::ProcessCompleted();
+
         // Tickar a Scene
         scene.TickAll(deltaTime);
         camera.Tick(deltaTime);
@@ -163,7 +175,28 @@ bool RenderAnimation(const std::string& outputDir, int totalFrames, ViewMode vie
         // Mostrar o FPS na tela
         if (currentTime - lastTimeShowedFPS > 1.0f)
         {
-            std::cout << "\rFPS: " << numOfFramesRenderedInLastSecond << std::flush;
+            std::cout << "\rFPS: " << numOfFramesRenderedInLastSecond;
+            if (ShaderRegistry::GetSettings().report && numOfFramesRenderedInLastSecond > 0)
+            {
+                // Médias sobre os frames do último segundo, depois recomeça
+                ShaderRegistry::CallStats& calls = ShaderRegistry::GetCallStats();
+                const size_t frames = static_cast<size_t>(numOfFramesRenderedInLastSecond);
+                std::cout << " | GL por frame: " << calls.uniformUploads / frames << " glUniform e "
+                          << calls.programBinds / frames << " glUseProgram enviados, " << calls.saved() / frames
+                          << " evitados (" << calls.redundantUploads / frames << " valores repetidos, "
+                          << calls.nameLookups / frames << " glGetUniformLocation, "
+                          << calls.redundantBinds / frames << " trocas de programa)";
+                calls = ShaderRegistry::CallStats{};
+
+                const RenderQueue::Stats& queue = renderer.getRenderStats();
+                std::cout << " | fila: " << queue.draws << " desenhos (" << queue.opaque << " opacos, " << queue.transparent
+                          << " transparentes), trocas de programa " << queue.programSwitches << ", de textura "
+                          << queue.textureSwitches << ", de geometria " << queue.meshSwitches;
+            }
+            const MeshRefiner::Status refining = MeshRefiner::GetStatus();
+            if (refining.pending > 0)
+                std::cout << " | Refinando " << refining.pending << " malha(s): " << static_cast<int>(refining.progress * 100.0f) << "%   ";
+            std::cout << std::flush;
             numOfFramesRenderedInLastSecond = 0;
             lastTimeShowedFPS = currentTime;
         }
@@ -179,6 +212,7 @@ int main(int argc, char* argv[]) {
     int frames = TOTAL_FRAMES;
     std::string outputDir = OUTPUT_DIR;
     ViewMode viewMode = ViewMode::INTERACTIVE; // Modo interativo por padrão
+    bool clearMeshCache = false;
     
     // Processar argumentos (se houver)
     if (argc > 1) {
@@ -205,6 +239,42 @@ int main(int argc, char* argv[]) {
                     viewMode = ViewMode::RENDER_ONLY;
                 }
             }
+            else if (arg == "--no-mesh-cache") {
+                MeshCache::GetSettings().enabled = false;
+            }
+            else if (arg == "--clear-mesh-cache") {
+                clearMeshCache = true;
+            }
+            else if (arg == "--mesh-cache-dir" && i + 1 < argc) {
+                MeshCache::GetSettings().directory = argv[++i];
+            }
+            else if (arg == "--no-progressive-meshes") {
+                MeshRefiner::GetSettings().enabled = false;
+            }
+            else if (arg == "--mesh-quality" && i + 1 < argc) {
+                if (!MeshQuality::Parse(argv[++i], MeshQuality::GetSettings().level)) {
+                    std::cerr << "Qualidade de malha desconhecida: " << argv[i] << " (use full, balanced ou draft)" << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "--glyph-mesher" && i + 1 < argc) {
+                if (!GlyphMesher::Parse(argv[++i], GlyphMesher::GetSettings().method)) {
+                    std::cerr << "Método de malha desconhecido: " << argv[i] << " (use extrusion, marching-cubes ou dual-contouring)" << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "--vertex-format" && i + 1 < argc) {
+                if (!VertexFormat::Parse(argv[++i], VertexFormat::GetSettings().defaultLayout)) {
+                    std::cerr << "Formato de vértice desconhecido: " << argv[i] << " (use float ou packed)" << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "--vertex-stats") {
+                VertexFormat::GetSettings().report = true;
+            }
+            else if (arg == "--gl-stats") {
+                ShaderRegistry::GetSettings().report = true;
+            }
             else if (arg == "--help") {
                 std::cout << "Uso: " << argv[0] << " [opções]" << std::endl;
                 std::cout << "Opções:" << std::endl;
@@ -213,12 +283,31 @@ int main(int argc, char* argv[]) {
                 std::cout << "  --frames N    Número total de frames (padrão: " << TOTAL_FRAMES << ")" << std::endl;
                 std::cout << "  --output DIR  Diretório de saída (padrão: " << OUTPUT_DIR << ")" << std::endl;
                 std::cout << "  --mode MODE   Modo de visualização (interactive/render, padrão: interactive)" << std::endl;
+                std::cout << "  --no-mesh-cache       Gera todas as malhas de novo, sem ler nem gravar o cache em disco" << std::endl;
+                std::cout << "  --clear-mesh-cache    Apaga o cache de malhas antes de começar" << std::endl;
+                std::cout << "  --mesh-cache-dir DIR  Diretório do cache de malhas (padrão: " << MeshCache::GetSettings().directory << ")" << std::endl;
+                std::cout << "  --no-progressive-meshes  Gera as malhas já na resolução final, sem prévia grossa" << std::endl;
+                std::cout << "  --mesh-quality Q      Simplificação das malhas: full (nenhuma), balanced (padrão) ou draft" << std::endl;
+                std::cout << "  --glyph-mesher M      Malha das letras e números: extrusion (padrão), marching-cubes ou dual-contouring" << std::endl;
+                std::cout << "  --vertex-format F     Formato dos vértices na GPU: packed (padrão, 16 B) ou float (32 B)" << std::endl;
+                std::cout << "  --vertex-stats        Mostra o tamanho de cada malha na GPU, quanto o formato economizou e o ACMR/ATVR" << std::endl;
+                std::cout << "  --gl-stats            Mostra junto do FPS as chamadas de uniform e de programa por frame, quantas o cache evitou e as trocas de estado da fila de desenho" << std::endl;
                 std::cout << "  --help        Exibir esta ajuda" << std::endl;
                 return 0;
             }
         }
     }
     
+    // Só depois de ler todos os argumentos: o --mesh-cache-dir pode vir depois do --clear-mesh-cache
+    if (clearMeshCache) {
+        MeshCache::Clear();
+    }
+
+    // Frames gravados têm que sair com a malha final desde o primeiro
+    if (viewMode == ViewMode::RENDER_ONLY) {
+        MeshRefiner::GetSettings().enabled = false;
+    }
+
     // Renderizar animação
     if (!RenderAnimation(outputDir, frames, viewMode)) {
         std::cerr << "Falha ao renderizar animação" << std::endl;
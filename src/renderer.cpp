@@ -37,8 +37,7 @@ bool Renderer::initialize()
     // Habilitar teste de profundidade
     glEnable(GL_DEPTH_TEST);
     
-    // Habilitar blending para transparência
-    glEnable(GL_BLEND);
+    // Blending para transparência; ligado só no passo dos transparentes (RenderQueue)
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Otimizações OpenGL
@@ -46,6 +45,7 @@ bool Renderer::initialize()
     glCullFace(GL_BACK);     // Culling de faces traseiras
 
     setupLights();
+    m_frameUniforms.create();
     
     return true;
 }
@@ -58,9 +58,19 @@ void Renderer::renderFrame(const Camera& camera, const Scene& scene, const float
     // Atualizar posições das luzes
     updateLights(deltaTime);
 
-    const std::vector<SceneObject*> sceneObjects = scene.GetObjectsFromScene();
-    for (const SceneObject* object : sceneObjects)
-        object->Draw(camera.getViewMatrix(), camera.getProjectionMatrix(m_window.getAspectRatio()), camera.GetObjectPosition(), m_lights);
+    // Câmera e luzes uma vez por frame; cada objeto só envia a própria matriz e o material
+    m_frameUniforms.update(camera.getViewMatrix(), camera.getProjectionMatrix(m_window.getAspectRatio()), camera.GetObjectPosition(), m_lights);
+
+    // Fila do frame: a ordem da cena não importa, a RenderQueue ordena por estado e profundidade
+    const glm::vec3 cameraPosition = camera.GetObjectPosition();
+    const glm::vec3 cameraFront = camera.getFront();
+    m_renderQueue.clear();
+    for (const SceneObject* object : scene.GetObjectsFromScene())
+    {
+        const float depth = glm::dot(object->GetObjectPosition() - cameraPosition, cameraFront);
+        m_renderQueue.add(*object->GetMesh(), object->GetTransform().getModelMatrix(), depth);
+    }
+    m_renderQueue.submit();
     
     m_window.update();
 }
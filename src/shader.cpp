@@ -1,74 +1,13 @@
 #include "shader.h"
 
-#include <fstream>
-#include <iostream>
+#include <cstring>
 #include <glad/glad.h>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath)
-    : m_vertexPath(vertexPath), m_fragmentPath(fragmentPath)
-{
-    // 1. Recuperar o código fonte do vertex/fragment shader a partir do caminho do arquivo
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vertexShaderFile;
-    std::ifstream fragmentShaderFile;
-    
-    // Garantir que os objetos ifstream possam lançar exceções
-    vertexShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fragmentShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    
-    try 
-    {
-        // Abrir arquivos
-        vertexShaderFile.open(vertexPath);
-        fragmentShaderFile.open(fragmentPath);
-        std::stringstream vertexShaderStream, fragmentShaderStream;
-        
-        // Ler conteúdo dos arquivos para os streams
-        vertexShaderStream << vertexShaderFile.rdbuf();
-        fragmentShaderStream << fragmentShaderFile.rdbuf();
-        
-        // Fechar manipuladores de arquivo
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
-        
-        // Converter stream para string
-        vertexCode = vertexShaderStream.str();
-        fragmentCode = fragmentShaderStream.str();
-    }
-    catch (std::ifstream::failure& e)
-    {
-        std::cout << "ERRO::SHADER::FALHA_AO_LER_ARQUIVO" << std::endl;
-    }
-    
-    const char* vertexShaderCode = vertexCode.c_str();
-    const char* fragmentShaderCode = fragmentCode.c_str();
-    
-    // 2. Compilar shaders
-    unsigned int vertex, fragment;
-    
-    // Vertex shader
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vertexShaderCode, NULL);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
-    
-    // Fragment Shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fragmentShaderCode, NULL);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
-    
-    // Programa de Shader
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
-    
-    // Excluir os shaders, pois já estão vinculados ao programa e não são mais necessários
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const std::vector<std::string>& defines)
+    : m_vertexPath(vertexPath), m_fragmentPath(fragmentPath), m_defines(defines),
+      m_program(ShaderRegistry::Acquire(m_vertexPath, m_fragmentPath, m_defines))
+{
+    ID = m_program->id;
 }
 
 std::string Shader::getVertexPath() const
@@ -81,79 +20,123 @@ std::string Shader::getFragmentPath() const
     return m_fragmentPath;
 }
 
+const std::vector<std::string>& Shader::getDefines() const
+{
+    return m_defines;
+}
+
 void Shader::use()
 { 
-    glUseProgram(ID); 
+    ShaderRegistry::UseProgram(ID);
+}
+
+namespace
+{
+    // Guarda o valor e diz se ele difere do último que o programa recebeu
+    template<typename T>
+    ShaderProgram::Uniform* Changed(ShaderProgram* program, const int slot, const T& value)
+    {
+        static_assert(sizeof(T) <= sizeof(ShaderProgram::Uniform::value), "valor maior que uma mat4");
+        if (!program || slot < 0) return nullptr;
+
+        ShaderProgram::Uniform& uniform = program->uniforms[static_cast<size_t>(slot)];
+        ShaderRegistry::CallStats& calls = ShaderRegistry::GetCallStats();
+        if (uniform.hasValue && std::memcmp(uniform.value, &value, sizeof(T)) == 0)
+        {
+            ++calls.redundantUploads;
+            return nullptr;
+        }
+        std::memcpy(uniform.value, &value, sizeof(T));
+        uniform.hasValue = true;
+        ++calls.uniformUploads;
+        return &uniform;
+    }
+
+    // Um setter por nome: agora uma busca na tabela, antes um glGetUniformLocation
+    template<typename T>
+    Shader::Uniform<T> ByName(const Shader& shader, const std::string& name)
+    {
+        ++ShaderRegistry::GetCallStats().nameLookups;
+        return shader.uniform<T>(name);
+    }
+}
+
+void Shader::set(const Uniform<bool> uniform, const bool value) const
+{
+    set(Uniform<int>{ uniform.slot }, static_cast<int>(value));
+}
+
+void Shader::set(const Uniform<int> uniform, const int value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniform1i(u->location, value);
+}
+
+void Shader::set(const Uniform<float> uniform, const float value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniform1f(u->location, value);
+}
+
+void Shader::set(const Uniform<glm::vec2> uniform, const glm::vec2& value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniform2f(u->location, value.x, value.y);
+}
+
+void Shader::set(const Uniform<glm::vec3> uniform, const glm::vec3& value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniform3f(u->location, value.x, value.y, value.z);
+}
+
+void Shader::set(const Uniform<glm::vec4> uniform, const glm::vec4& value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniform4f(u->location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::set(const Uniform<glm::mat4> uniform, const glm::mat4& value) const
+{
+    if (const auto* u = Changed(m_program.get(), uniform.slot, value)) glUniformMatrix4fv(u->location, 1, GL_FALSE, &value[0][0]);
 }
 
 void Shader::setBool(const std::string &name, bool value) const
 {         
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value); 
+    set(ByName<bool>(*this, name), value);
 }
 
 void Shader::setInt(const std::string &name, int value) const
 { 
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value); 
+    set(ByName<int>(*this, name), value);
 }
 
 void Shader::setFloat(const std::string &name, float value) const
 { 
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value); 
+    set(ByName<float>(*this, name), value);
 }
 
 void Shader::setSampler(const std::string &name, unsigned int position) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), position);
+    set(ByName<int>(*this, name), static_cast<int>(position));
 }
 
 void Shader::setVec4(const std::string &name, double values[]) const
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), 
-               values[0], values[1], values[2], values[3]);
+    set(ByName<glm::vec4>(*this, name), glm::vec4(values[0], values[1], values[2], values[3]));
 }
 
 void Shader::setVec2(const std::string &name, double values[]) const
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), values[0], values[1]);
+    set(ByName<glm::vec2>(*this, name), glm::vec2(values[0], values[1]));
 }
 
 void Shader::setVec2(const std::string &name, glm::vec2 vector) const
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), vector[0], vector[1]);
+    set(ByName<glm::vec2>(*this, name), vector);
 }
 
 void Shader::setVec3(const std::string &name, glm::vec3 vector) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), vector[0], vector[1], vector[2]);
+    set(ByName<glm::vec3>(*this, name), vector);
 }
 
 void Shader::setMat4(const std::string &name, glm::mat4 matrix) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &matrix[0][0]);
-}
-
-void Shader::checkCompileErrors(unsigned int shader, std::string type)
-{
-    int success;
-    char infoLog[1024];
-    if (type != "PROGRAM")
-    {
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERRO::SHADER::COMPILACAO_FALHOU do tipo: " << type << "\n" 
-                      << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-        }
-    }
-    else
-    {
-        glGetProgramiv(shader, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-            std::cout << "ERRO::PROGRAMA::VINCULACAO_FALHOU do tipo: " << type << "\n" 
-                      << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-        }
-    }
+    set(ByName<glm::mat4>(*this, name), matrix);
 }
@@ -0,0 +1,156 @@
+// Precisão e microbenchmark das versões SoA (SIMD::FloatLanes) das primitivas do CSGImplementable.
+//
+// Cada primitiva e cada combinador é avaliado nos mesmos pontos aleatórios pela versão escalar (glm::vec3) e pela
+// versão em lanes (FloatLanes::Width pontos por vez). A diferença tem que ficar dentro de TOLERANCE, relativa ao
+// módulo da distância (mínimo 1); o tempo das duas versões é medido em ns por ponto.
+//
+// Uso: CSGLanesTest [pontos]   (padrão 1048576). Sai com 1 se alguma primitiva passar da tolerância.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Object/Meshes/CSGImplementable.h"
+
+namespace
+{
+    // Mesmas operações nas duas versões; só o arredondamento de sqrt/divisão e a contração em FMA podem diferir
+    constexpr float TOLERANCE = 1e-5f;
+
+    // As primitivas são protected: os glifos as herdam
+    struct Primitives : CSGImplementable
+    {
+        using CSGImplementable::opUnion;
+        using CSGImplementable::opIntersection;
+        using CSGImplementable::opSubtract;
+        using CSGImplementable::rotateZ;
+        using CSGImplementable::planeSDF;
+        using CSGImplementable::boxSDF;
+        using CSGImplementable::rotatedRightTriangleSDF;
+        using CSGImplementable::rightTrianglePrismSDF;
+        using CSGImplementable::boxExtrudedSDF;
+        using CSGImplementable::cappedCylinderSDF;
+        using CSGImplementable::quarterCylinderSDF;
+        using CSGImplementable::slopePlaneSDF;
+        using CSGImplementable::wedgeSDF;
+        using CSGImplementable::cylinderSDF;
+        using CSGImplementable::ellipticalCylinderSDF;
+        using CSGImplementable::cappedEllipticalCylinderSDF;
+        using CSGImplementable::truncatedPrismSDF;
+    };
+
+    struct Points
+    {
+        std::vector<float> xs, ys, zs;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double NanosecondsPerPoint(const Clock::time_point start, const size_t count)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(count);
+    }
+
+    // Avalia `fn` com os dois tipos de ponto nos mesmos pontos; retorna false se alguma lane sair da tolerância
+    template<typename Fn>
+    bool Compare(const char* name, const Fn& fn, const Points& points)
+    {
+        const size_t n = points.xs.size();
+        std::vector<float> scalar(n), lanes(n);
+
+        const Clock::time_point scalarStart = Clock::now();
+        for (size_t i = 0; i < n; ++i) scalar[i] = fn(glm::vec3(points.xs[i], points.ys[i], points.zs[i]));
+        const double scalarTime = NanosecondsPerPoint(scalarStart, n);
+
+        const Clock::time_point lanesStart = Clock::now();
+        SIMD::evaluateBatch(points.xs.data(), points.ys.data(), points.zs.data(), lanes.data(), n, fn);
+        const double lanesTime = NanosecondsPerPoint(lanesStart, n);
+
+        double maxError = 0.0;
+        size_t failures = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const float error = std::fabs(lanes[i] - scalar[i]);
+            maxError = std::max(maxError, static_cast<double>(error));
+            failures += error > TOLERANCE * std::max(1.0f, std::fabs(scalar[i]));
+        }
+
+        std::printf("%-28s escalar %6.2f ns  lanes %6.2f ns  x%4.1f  erro máx %.2e  %s\n", name, scalarTime, lanesTime,
+                    scalarTime / lanesTime, maxError, failures ? "FALHOU" : "ok");
+        if (failures) std::printf("    %zu de %zu pontos fora da tolerância\n", failures, n);
+        return failures == 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "Uso: %s [pontos]\n", argv[0]);
+        return 1;
+    }
+
+    // Caixa um pouco maior que os volumes de amostragem dos glifos, para toda primitiva ter pontos dentro e fora
+    Points points;
+    points.xs.resize(count);
+    points.ys.resize(count);
+    points.zs.resize(count);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coordinate(-1.5f, 1.5f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.xs[i] = coordinate(rng);
+        points.ys[i] = coordinate(rng);
+        points.zs[i] = coordinate(rng);
+    }
+
+    std::printf("%zu pontos, FloatLanes::Width = %d, tolerância %.0e (relativa, mínimo 1)\n", count, SIMD::FloatLanes::Width,
+                static_cast<double>(TOLERANCE));
+
+    using P = Primitives;
+    const glm::vec3 a(0.0f, 0.0f, -0.2f), b(0.0f, 0.0f, 0.2f);
+    bool ok = true;
+
+    ok &= Compare("planeSDF", [](const auto& p) { return P::planeSDF(p, glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f)), 0.3f); }, points);
+    ok &= Compare("boxSDF", [](const auto& p) { return P::boxSDF(p, glm::vec3(0.5f, 0.625f, 0.1f)); }, points);
+    ok &= Compare("rotatedRightTriangleSDF", [](const auto& p) { return P::rotatedRightTriangleSDF(p, glm::vec2(0.6f, 0.4f), 0.3f, 35.0f); }, points);
+    ok &= Compare("rightTrianglePrismSDF", [](const auto& p) { return P::rightTrianglePrismSDF(p, glm::vec2(0.6f, 0.4f), 0.3f); }, points);
+    ok &= Compare("boxExtrudedSDF", [](const auto& p) { return P::boxExtrudedSDF(p, 0.4f, 0.2f, 0.5f); }, points);
+    ok &= Compare("cappedCylinderSDF", [&](const auto& p) { return P::cappedCylinderSDF(p, a, b, 0.45f); }, points);
+    ok &= Compare("quarterCylinderSDF", [&](const auto& p)
+    {
+        return P::quarterCylinderSDF(p, a, b, 0.45f, glm::vec3(-1.0f, 0.0f, 0.0f), 0.0f, glm::vec3(0.0f, -1.0f, 0.0f), 0.0f);
+    }, points);
+    ok &= Compare("slopePlaneSDF", [](const auto& p) { return P::slopePlaneSDF(p, 0.3f, 0.8f); }, points);
+    ok &= Compare("wedgeSDF", [](const auto& p) { return P::wedgeSDF(p, 0.3f, 0.2f, 0.8f); }, points);
+    ok &= Compare("cylinderSDF", [&](const auto& p) { return P::cylinderSDF(p, a, b, 0.45f); }, points);
+    ok &= Compare("ellipticalCylinderSDF", [](const auto& p) { return P::ellipticalCylinderSDF(p, 0.6f, 0.35f); }, points);
+    ok &= Compare("cappedEllipticalCylinderSDF", [](const auto& p) { return P::cappedEllipticalCylinderSDF(p, 0.6f, 0.35f, 0.4f); }, points);
+    ok &= Compare("truncatedPrismSDF", [](const auto& p)
+    {
+        return P::truncatedPrismSDF(p, glm::vec2(0.5f, 0.3f), glm::vec2(0.2f, 0.3f), 1.2f);
+    }, points);
+
+    // rotateZ e os combinadores, sobre primitivas já verificadas acima
+    ok &= Compare("rotateZ + boxSDF", [](const auto& p) { return P::boxSDF(P::rotateZ(p, 30.0f), glm::vec3(0.5f, 0.1f, 0.2f)); }, points);
+    ok &= Compare("opUnion", [&](const auto& p)
+    {
+        return P::opUnion(P::boxSDF(p, glm::vec3(0.5f, 0.2f, 0.2f)), P::cappedCylinderSDF(p, a, b, 0.45f));
+    }, points);
+    ok &= Compare("opIntersection", [&](const auto& p)
+    {
+        return P::opIntersection(P::boxSDF(p, glm::vec3(0.5f, 0.2f, 0.2f)), P::cappedCylinderSDF(p, a, b, 0.45f));
+    }, points);
+    ok &= Compare("opSubtract", [&](const auto& p)
+    {
+        return P::opSubtract(P::cappedCylinderSDF(p, a, b, 0.45f), P::cappedCylinderSDF(p, a, b, 0.225f));
+    }, points);
+
+    std::printf(ok ? "Todas as primitivas dentro da tolerância\n" : "Há primitivas fora da tolerância\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Verificação da chave e da ordenação da RenderQueue (sem OpenGL: só RenderQueueKey.cpp).
+//
+//  - SortByKey tem que dar a mesma ordem que std::stable_sort em conjuntos aleatórios de chaves: poucos estados
+//    (as passadas puladas), chaves de 64 bits quaisquer e chaves reais do MakeKey;
+//  - MakeKey tem que manter o layout: opacos antes dos transparentes, opacos agrupados por programa, textura e
+//    geometria e da frente para trás dentro do mesmo estado, transparentes de trás para frente com o estado só
+//    desempatando, e ids maiores que o campo truncados sem invadir os outros campos.
+//
+// Uso: RenderQueueTest [conjuntos]   (padrão 200). Sai com 1 se alguma verificação falhar.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "RenderQueue.h"
+
+namespace
+{
+    int failures = 0;
+
+    void Expect(const bool condition, const char* what)
+    {
+        if (condition) return;
+        std::printf("FALHOU: %s\n", what);
+        ++failures;
+    }
+
+    bool SortMatches(const std::vector<uint64_t>& keys)
+    {
+        std::vector<uint32_t> order, scratch;
+        RenderQueue::SortByKey(keys, order, scratch);
+
+        std::vector<uint32_t> expected(keys.size());
+        std::iota(expected.begin(), expected.end(), 0u);
+        std::stable_sort(expected.begin(), expected.end(), [&](const uint32_t a, const uint32_t b) { return keys[a] < keys[b]; });
+        return order == expected;
+    }
+
+    void CheckSort(const int sets)
+    {
+        std::mt19937_64 rng(1);
+        std::uniform_int_distribution<size_t> size(0, 5000);
+        int mismatches = 0;
+        for (int set = 0; set < sets; ++set)
+        {
+            const size_t n = set < 3 ? static_cast<size_t>(set) : size(rng);
+            std::vector<uint64_t> keys(n);
+            switch (set % 3)
+            {
+                case 0:
+                    // Poucos valores distintos e repetidos: a estabilidade e as passadas puladas
+                    for (uint64_t& key : keys) key = (rng() % 4) << 40 | (rng() % 3) << 8;
+                    break;
+                case 1:
+                    for (uint64_t& key : keys) key = rng();
+                    break;
+                default:
+                {
+                    std::uniform_real_distribution<float> depth(0.0f, 100.0f);
+                    for (uint64_t& key : keys)
+                        key = RenderQueue::MakeKey(rng() % 5 == 0, 1 + rng() % 3, rng() % 4, 1 + rng() % 40, depth(rng));
+                    break;
+                }
+            }
+            mismatches += !SortMatches(keys);
+        }
+        std::printf("SortByKey contra std::stable_sort: %d de %d conjuntos diferentes\n", mismatches, sets);
+        failures += mismatches;
+    }
+
+    void CheckKeys()
+    {
+        using Q = RenderQueue;
+        constexpr uint64_t TRANSPARENT = uint64_t(1) << 63;
+
+        // Passo
+        Expect(Q::MakeKey(false, 4095, 4095, 16383, 1e30f) < Q::MakeKey(true, 0, 0, 0, 0.0f), "opaco antes de transparente");
+        Expect((Q::MakeKey(false, 4095, 4095, 16383, 1e30f) & TRANSPARENT) == 0, "bit 63 de um opaco");
+        Expect((Q::MakeKey(true, 0, 0, 0, 0.0f) & TRANSPARENT) != 0, "bit 63 de um transparente");
+
+        // Opacos: estado na frente da profundidade, programa > textura > geometria, depois da frente para trás
+        Expect(Q::MakeKey(false, 1, 0, 0, 1.0f) < Q::MakeKey(false, 1, 0, 0, 2.0f), "opaco: mais perto primeiro");
+        Expect(Q::MakeKey(false, 1, 0, 0, 1e30f) < Q::MakeKey(false, 2, 0, 0, 0.0f), "opaco: programa antes da profundidade");
+        Expect(Q::MakeKey(false, 1, 4095, 16383, 0.0f) < Q::MakeKey(false, 2, 0, 0, 0.0f), "opaco: programa antes da textura");
+        Expect(Q::MakeKey(false, 1, 1, 16383, 0.0f) < Q::MakeKey(false, 1, 2, 0, 0.0f), "opaco: textura antes da geometria");
+        Expect(Q::MakeKey(false, 1, 1, 1, 1e30f) < Q::MakeKey(false, 1, 1, 2, 0.0f), "opaco: geometria antes da profundidade");
+
+        // Transparentes: de trás para frente, estado só desempata
+        Expect(Q::MakeKey(true, 4095, 4095, 16383, 2.0f) < Q::MakeKey(true, 0, 0, 0, 1.0f), "transparente: mais longe primeiro");
+        Expect(Q::MakeKey(true, 1, 0, 0, 1.0f) < Q::MakeKey(true, 2, 0, 0, 1.0f), "transparente: estado desempata");
+
+        // Profundidade: monótona em toda a faixa (a quantização junta valores próximos, nunca inverte), negativos e NaN valem 0
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> exponent(-20.0f, 20.0f);
+        bool monotonic = true;
+        for (int i = 0; i < 100000; ++i)
+        {
+            float a = std::exp2(exponent(rng)), b = std::exp2(exponent(rng));
+            if (a > b) std::swap(a, b);
+            monotonic &= Q::MakeKey(false, 7, 7, 7, a) <= Q::MakeKey(false, 7, 7, 7, b);
+            monotonic &= Q::MakeKey(true, 7, 7, 7, a) >= Q::MakeKey(true, 7, 7, 7, b);
+        }
+        Expect(monotonic, "profundidade monótona");
+        Expect(Q::MakeKey(false, 3, 3, 3, -5.0f) == Q::MakeKey(false, 3, 3, 3, 0.0f), "profundidade negativa vale 0");
+        Expect(Q::MakeKey(false, 3, 3, 3, std::nanf("")) == Q::MakeKey(false, 3, 3, 3, 0.0f), "profundidade NaN vale 0");
+        Expect(Q::MakeKey(false, 0, 0, 0, 1.0f) != Q::MakeKey(false, 0, 0, 0, 1.001f), "profundidade com 25 bits distingue 0,1%");
+
+        // Campos truncados nos 12/12/14 bits de baixo, sem invadir o vizinho
+        Expect(Q::MakeKey(false, 4096 + 5, 0, 0, 1.0f) == Q::MakeKey(false, 5, 0, 0, 1.0f), "programa com 12 bits");
+        Expect(Q::MakeKey(false, 0, 4096 + 5, 0, 1.0f) == Q::MakeKey(false, 0, 5, 0, 1.0f), "textura com 12 bits");
+        Expect(Q::MakeKey(false, 0, 0, 16384 + 5, 1.0f) == Q::MakeKey(false, 0, 0, 5, 1.0f), "geometria com 14 bits");
+        Expect(Q::MakeKey(true, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 1.0f) == Q::MakeKey(true, 4095, 4095, 16383, 1.0f),
+            "transparente: ids truncados");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int sets = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (sets < 1)
+    {
+        std::fprintf(stderr, "Uso: %s [conjuntos]\n", argv[0]);
+        return 1;
+    }
+
+    CheckSort(sets);
+    CheckKeys();
+
+    std::printf(failures == 0 ? "Chaves e ordenação da RenderQueue ok\n" : "Há verificações que falharam\n");
+    return failures == 0 ? 0 : 1;
+}
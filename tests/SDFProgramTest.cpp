@@ -0,0 +1,185 @@
+// Verificação do SDFProgram: bytecode contra o SDF escrito à mão, poda por intervalos e limites de bounds().
+//
+// Cada forma existe duas vezes: como lambda genérica sobre as primitivas do CSGImplementable (como os glifos) e como
+// SDFProgram::Expr compilada. Em pontos aleatórios e em linhas de grade (a ordem em que o Polygonizer amostra):
+//   - o bytecode tem que dar o mesmo valor que a lambda, escalar e em lote;
+//   - o lote podado tem que dar exatamente o mesmo que o lote sem poda;
+//   - bounds() de caixas aleatórias tem que conter o valor de todo ponto amostrado dentro delas.
+//
+// Uso: SDFProgramTest [resolução da grade]   (padrão 64). Sai com 1 se alguma verificação falhar.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Object/Meshes/CSGImplementable.h"
+#include "SDFProgram/Program.h"
+
+namespace
+{
+    // O interpretador reusa as primitivas genéricas do CSGImplementable: só a contração em FMA pode diferir
+    constexpr float TOLERANCE = 1e-6f;
+    // Folga do intervalo: a aritmética intervalar arredonda para o mais próximo, não para fora
+    constexpr float BOUNDS_SLACK = 1e-5f;
+
+    struct Primitives : CSGImplementable
+    {
+        using CSGImplementable::opUnion;
+        using CSGImplementable::opIntersection;
+        using CSGImplementable::opSubtract;
+        using CSGImplementable::rotateZ;
+        using CSGImplementable::planeSDF;
+        using CSGImplementable::boxSDF;
+        using CSGImplementable::boxExtrudedSDF;
+        using CSGImplementable::cappedCylinderSDF;
+        using CSGImplementable::cylinderSDF;
+        using CSGImplementable::cappedEllipticalCylinderSDF;
+        using CSGImplementable::truncatedPrismSDF;
+        using CSGImplementable::rightTrianglePrismSDF;
+        using CSGImplementable::rotatedRightTriangleSDF;
+        using CSGImplementable::wedgeSDF;
+    };
+    using P = Primitives;
+
+    struct Points
+    {
+        std::vector<float> xs, ys, zs;
+
+        void push(const glm::vec3& p)
+        {
+            xs.push_back(p.x);
+            ys.push_back(p.y);
+            zs.push_back(p.z);
+        }
+        [[nodiscard]] size_t size() const { return xs.size(); }
+        [[nodiscard]] glm::vec3 operator[](const size_t i) const { return { xs[i], ys[i], zs[i] }; }
+    };
+
+    bool Close(const float a, const float b)
+    {
+        return std::fabs(a - b) <= TOLERANCE * std::max(1.0f, std::fabs(b));
+    }
+
+    template<typename Fn>
+    bool Check(const char* name, const Fn& hand, SDFProgram::Program program, const Points& random, const Points& grid)
+    {
+        size_t scalarFailures = 0, batchFailures = 0, pruneFailures = 0, boundsFailures = 0;
+
+        // Escalar
+        for (size_t i = 0; i < random.size(); ++i)
+            scalarFailures += !Close(program(random[i]), hand(random[i]));
+
+        // Lote, com e sem poda, na ordem da grade (os blocos de PRUNE_BLOCK pontos são locais e a poda atua)
+        const size_t n = grid.size();
+        std::vector<float> expected(n), pruned(n), unpruned(n);
+        SIMD::evaluateBatch(grid.xs.data(), grid.ys.data(), grid.zs.data(), expected.data(), n, hand);
+        program.setPruning(true);
+        program.evaluate(grid.xs.data(), grid.ys.data(), grid.zs.data(), pruned.data(), n);
+        program.setPruning(false);
+        program.evaluate(grid.xs.data(), grid.ys.data(), grid.zs.data(), unpruned.data(), n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            batchFailures += !Close(unpruned[i], expected[i]);
+            pruneFailures += pruned[i] != unpruned[i];
+        }
+
+        // bounds() contém tudo o que foi amostrado na caixa, de caixas do tamanho de uma célula até o domínio todo
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (int box = 0; box < 512; ++box)
+        {
+            const float size = 1.5f * std::pow(unit(rng), 3.0f) + 0.01f;
+            const glm::vec3 lo(unit(rng) * 3.0f - 1.5f, unit(rng) * 3.0f - 1.5f, unit(rng) * 3.0f - 1.5f);
+            const glm::vec3 hi = lo + glm::vec3(size);
+            const MathUtils::Interval range = program.bounds(lo, hi);
+            for (int s = 0; s < 64; ++s)
+            {
+                const glm::vec3 t(unit(rng), unit(rng), unit(rng));
+                const float value = hand(lo + t * (hi - lo));
+                const float slack = BOUNDS_SLACK * std::max(1.0f, std::fabs(value));
+                boundsFailures += value < range.lo - slack || value > range.hi + slack;
+            }
+        }
+
+        // Numa caixa pequena perto de um canto, a poda tem que remover instruções (senão o teste acima não vale nada)
+        std::vector<SDFProgram::Instruction> specialized;
+        program.specialize(glm::vec3(1.2f), glm::vec3(1.3f), specialized);
+
+        const bool ok = scalarFailures == 0 && batchFailures == 0 && pruneFailures == 0 && boundsFailures == 0
+            && specialized.size() < program.instructionCount();
+        std::printf("%-10s %2zu instruções (%2zu podado)  escalar %zu  lote %zu  poda %zu  bounds %zu  %s\n", name,
+            program.instructionCount(), specialized.size(), scalarFailures, batchFailures, pruneFailures, boundsFailures,
+            ok ? "ok" : "FALHOU");
+        return ok;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int resolution = argc > 1 ? std::atoi(argv[1]) : 64;
+    if (resolution < 2)
+    {
+        std::fprintf(stderr, "Uso: %s [resolução da grade]\n", argv[0]);
+        return 1;
+    }
+
+    Points random;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coordinate(-1.5f, 1.5f);
+    for (int i = 0; i < 65536; ++i)
+        random.push(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)));
+
+    Points grid;
+    const float step = 3.0f / static_cast<float>(resolution - 1);
+    for (int z = 0; z < resolution; ++z)
+        for (int y = 0; y < resolution; ++y)
+            for (int x = 0; x < resolution; ++x)
+                grid.push(glm::vec3(-1.5f) + step * glm::vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)));
+
+    using namespace SDFProgram;
+    const glm::vec3 a(0.0f, 0.0f, -0.2f), b(0.0f, 0.0f, 0.2f);
+    bool ok = true;
+
+    // Anel cortado por um plano (a forma do C)
+    ok &= Check("anel", [&](const auto& p)
+    {
+        return P::opIntersection(P::opSubtract(P::cappedCylinderSDF(p, a, b, 0.65f), P::cylinderSDF(p, a, b, 0.45f)),
+            P::planeSDF(p, glm::vec3(1.0f, 0.0f, 0.0f), 0.3f));
+    }, Program::Compile(Intersection(Subtract(CappedCylinder(a, b, 0.65f), Cylinder(a, b, 0.45f)),
+        Plane(glm::vec3(1.0f, 0.0f, 0.0f), 0.3f))), random, grid);
+
+    // Barras transladadas e giradas, unidas e recortadas: passa de MIN_PRUNE_INSTRUCTIONS, então a poda atua
+    ok &= Check("barras", [&](const auto& p)
+    {
+        const auto left = P::boxSDF(p - glm::vec3(-0.5f, 0.0f, 0.0f), glm::vec3(0.12f, 0.7f, 0.2f));
+        const auto right = P::boxSDF(p - glm::vec3(0.5f, 0.0f, 0.0f), glm::vec3(0.12f, 0.7f, 0.2f));
+        const auto diagonal = P::boxSDF(P::rotateZ(p, 35.0f), glm::vec3(0.12f, 0.8f, 0.2f));
+        const auto top = P::boxExtrudedSDF(p - glm::vec3(0.0f, 0.6f, 0.0f), 0.6f, 0.2f, 0.1f);
+        const auto hole = P::cappedEllipticalCylinderSDF(p - glm::vec3(0.0f, -0.4f, 0.0f), 0.2f, 0.1f, 0.3f);
+        const auto prism = P::truncatedPrismSDF(p - glm::vec3(0.0f, -0.7f, 0.0f), glm::vec2(0.5f, 0.2f), glm::vec2(0.3f, 0.2f), 0.2f);
+        const auto wedge = P::wedgeSDF(p - glm::vec3(0.8f, 0.8f, 0.0f), 0.2f, 0.2f, 0.3f);
+        const auto triangle = P::rotatedRightTriangleSDF(p - glm::vec3(-0.8f, 0.8f, 0.0f), glm::vec2(0.3f, 0.2f), 0.3f, 20.0f);
+        const auto shape = P::opUnion(P::opUnion(P::opUnion(left, right), P::opUnion(diagonal, top)),
+            P::opUnion(P::opUnion(prism, wedge), triangle));
+        return P::opIntersection(P::opSubtract(shape, hole), P::planeSDF(p, glm::vec3(0.0f, 0.0f, 1.0f), 0.15f));
+    }, Program::Compile([&]
+    {
+        const Expr bar = Box(glm::vec3(0.12f, 0.7f, 0.2f));
+        const Expr left = Translate(bar, glm::vec3(-0.5f, 0.0f, 0.0f));
+        const Expr right = Translate(bar, glm::vec3(0.5f, 0.0f, 0.0f));
+        const Expr diagonal = RotateZ(Box(glm::vec3(0.12f, 0.8f, 0.2f)), 35.0f);
+        const Expr top = Translate(BoxExtruded(0.6f, 0.2f, 0.1f), glm::vec3(0.0f, 0.6f, 0.0f));
+        const Expr hole = Translate(CappedEllipticalCylinder(0.2f, 0.1f, 0.3f), glm::vec3(0.0f, -0.4f, 0.0f));
+        const Expr prism = Translate(TruncatedPrism(glm::vec2(0.5f, 0.2f), glm::vec2(0.3f, 0.2f), 0.2f), glm::vec3(0.0f, -0.7f, 0.0f));
+        const Expr wedge = Translate(Wedge(0.2f, 0.2f, 0.3f), glm::vec3(0.8f, 0.8f, 0.0f));
+        const Expr triangle = Translate(RotatedRightTriangle(glm::vec2(0.3f, 0.2f), 0.3f, 20.0f), glm::vec3(-0.8f, 0.8f, 0.0f));
+        const Expr shape = Union(Union(Union(left, right), Union(diagonal, top)), Union(Union(prism, wedge), triangle));
+        return Intersection(Subtract(shape, hole), Plane(glm::vec3(0.0f, 0.0f, 1.0f), 0.15f));
+    }()), random, grid);
+
+    std::printf(ok ? "Bytecode, poda e limites conferem com os SDFs escritos à mão\n" : "Há formas que não conferem\n");
+    return ok ? 0 : 1;
+}
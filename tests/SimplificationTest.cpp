@@ -0,0 +1,152 @@
+// Verificação do Simplification::SimplifyMesh em malhas do Polygonizer.
+//
+// Para cada forma e cada configuração (só maxError, e maxError com alvo de triângulos):
+//   - a saída tem que ser a mesma, byte a byte, com 1, 2, 3 e todas as threads (a divisão em fatias depende só da malha);
+//   - a simplificação não pode abrir a malha: as arestas de um triângulo só (ou de mais de dois), contadas sobre os
+//     pontos (vértices no mesmo lugar são o mesmo ponto), têm que ser as mesmas da entrada;
+//   - e tem que tirar triângulos de fato, senão as verificações acima não dizem nada.
+//
+// Uso: SimplificationTest [resolução]   (padrão 128 células no eixo mais longo). Sai com 1 se alguma verificação falhar.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "MarchingCubes/Polygonizer.h"
+#include "Object/Meshes/CSGImplementable.h"
+#include "Simplification/Simplification.h"
+
+namespace
+{
+    struct Shapes : CSGImplementable
+    {
+        // Anel cortado (o C): faces planas, que colapsam muito, e paredes curvas, que colapsam pouco
+        static auto Ring()
+        {
+            return makeLaneSDF([](const auto& p)
+            {
+                const glm::vec3 a(0.0f, 0.0f, -0.3f), b(0.0f, 0.0f, 0.3f);
+                const auto ring = opSubtract(cylinderSDF(p, a, b, 0.65f), cylinderSDF(p, a, b, 0.45f));
+                const auto cut = opIntersection(ring, planeSDF(p, glm::vec3(1.0f, 0.0f, 0.0f), 0.3f));
+                return opIntersection(opIntersection(cut, planeSDF(p, glm::vec3(0.0f, 0.0f, 1.0f), 0.2f)),
+                    planeSDF(p, glm::vec3(0.0f, 0.0f, -1.0f), 0.2f));
+            });
+        }
+
+        // Caixa furada maior que o volume de amostragem: a malha sai aberta nas faces do volume
+        static auto OpenBox()
+        {
+            return makeLaneSDF([](const auto& p)
+            {
+                return opSubtract(boxSDF(p, glm::vec3(0.5f, 0.5f, 2.0f)), cylinderSDF(p, glm::vec3(0.0f, 0.0f, -1.0f),
+                    glm::vec3(0.0f, 0.0f, 1.0f), 0.25f));
+            });
+        }
+    };
+
+    using PointKey = std::tuple<float, float, float>;
+    using EdgeKey = std::pair<unsigned int, unsigned int>;
+
+    // Arestas abertas ou com mais de dois triângulos, sobre os pontos
+    std::vector<std::pair<PointKey, PointKey>> OpenEdges(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+    {
+        std::map<PointKey, unsigned int> pointOf;
+        std::vector<PointKey> points;
+        std::vector<unsigned int> point(vertices.size() / 8);
+        for (size_t v = 0; v < point.size(); ++v)
+        {
+            const PointKey key(vertices[8 * v], vertices[8 * v + 1], vertices[8 * v + 2]);
+            const auto inserted = pointOf.emplace(key, static_cast<unsigned int>(points.size()));
+            if (inserted.second) points.push_back(key);
+            point[v] = inserted.first->second;
+        }
+
+        std::map<EdgeKey, int> uses;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+            for (int c = 0; c < 3; ++c)
+            {
+                const unsigned int a = point[indices[t + c]], b = point[indices[t + (c + 1) % 3]];
+                ++uses[{ std::min(a, b), std::max(a, b) }];
+            }
+
+        std::vector<std::pair<PointKey, PointKey>> open;
+        for (const auto& [edge, count] : uses)
+            if (count != 2) open.emplace_back(points[edge.first], points[edge.second]);
+        return open;
+    }
+
+    template<typename SDF>
+    bool Check(const char* name, const SDF& sdf, const int resolution, const Simplification::Settings& base)
+    {
+        const glm::vec3 minCorner(-0.75f, -0.75f, -0.35f), maxCorner(0.75f, 0.75f, 0.35f);
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        Polygonizer::Settings polygonizer;
+        polygonizer.threadCount = 0;
+        polygonizer.normalMode = Polygonizer::NormalMode::Analytic;
+        Polygonizer::PolygonizeSurface(sdf, minCorner, maxCorner, Polygonizer::IsotropicCells(minCorner, maxCorner, resolution),
+            vertices, indices, polygonizer);
+        const auto inputOpen = OpenEdges(vertices, indices);
+
+        bool ok = true;
+        std::vector<float> firstVertices;
+        std::vector<unsigned int> firstIndices;
+        Simplification::Stats stats;
+        for (const unsigned int threads : { 1u, 2u, 3u, 0u })
+        {
+            std::vector<float> v = vertices;
+            std::vector<unsigned int> i = indices;
+            Simplification::Settings settings = base;
+            settings.threadCount = threads;
+            settings.stats = &stats;
+            Simplification::SimplifyMesh(v, i, settings);
+
+            if (threads == 1)
+            {
+                firstVertices = v;
+                firstIndices = i;
+                const bool closed = OpenEdges(v, i) == inputOpen;
+                const bool reduced = stats.outputTriangles * 2 < stats.inputTriangles;
+                std::printf("%-10s %7zu -> %6zu triângulos (%zu colapsos em paralelo)  %zu arestas abertas  %s\n", name,
+                    stats.inputTriangles, stats.outputTriangles, stats.parallelCollapses, inputOpen.size(),
+                    closed && reduced ? "ok" : closed ? "FALHOU: quase não simplificou" : "FALHOU: abriu ou fechou arestas");
+                ok &= closed && reduced && stats.parallelCollapses > 0;
+            }
+            else if (v != firstVertices || i != firstIndices)
+            {
+                std::printf("%-10s saída com %u threads diferente da serial  FALHOU\n", name, threads);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int resolution = argc > 1 ? std::atoi(argv[1]) : 128;
+    if (resolution < 8)
+    {
+        std::fprintf(stderr, "Uso: %s [resolução]\n", argv[0]);
+        return 1;
+    }
+
+    Simplification::Settings errorOnly;
+    errorOnly.maxError = 1e-3f;
+
+    Simplification::Settings withTarget = errorOnly;
+    withTarget.maxError = 2e-3f;
+    withTarget.targetTriangles = 4000;
+
+    bool ok = true;
+    ok &= Check("anel", Shapes::Ring(), resolution, errorOnly);
+    ok &= Check("anel/alvo", Shapes::Ring(), resolution, withTarget);
+    ok &= Check("aberta", Shapes::OpenBox(), resolution, errorOnly);
+    ok &= Check("aberta/alvo", Shapes::OpenBox(), resolution, withTarget);
+
+    std::printf(ok ? "Simplificação determinística e sem arestas novas abertas\n" : "Há verificações que falharam\n");
+    return ok ? 0 : 1;
+}